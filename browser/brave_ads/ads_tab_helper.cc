@@ -8,10 +8,13 @@
 #include <memory>
 #include <utility>
 
+#include "base/strings/stringprintf.h"
 #include "brave/browser/brave_ads/ads_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
+#include "chrome/browser/search_engines/template_url_service_factory.h"
 #include "components/dom_distiller/content/browser/distiller_javascript_utils.h"
 #include "components/dom_distiller/content/browser/distiller_page_web_contents.h"
+#include "components/search_engines/template_url_service.h"
 #include "components/sessions/content/session_tab_helper.h"
 #include "content/public/browser/navigation_handle.h"
 #include "content/public/browser/render_frame_host.h"
@@ -27,6 +30,101 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Text classification only needs a sample of the page, so text is capped in
+// the renderer rather than forcing layout with innerText and sending the
+// whole of a large document across IPC
+constexpr size_t kMaxTextLength = 256 * 1024;
+
+// Walks the rendered text nodes of the body until |kMaxTextLength| characters
+// have been read. Like innerText, subtrees which are not rendered are skipped,
+// text nodes are joined without separators so that words split by inline
+// elements such as <b> stay whole, and a line break is added around other
+// elements. Unlike innerText, this only needs computed styles, not layout
+constexpr char kExtractTextScript[] = R"(
+  (function() {
+    const maxLength = %zu;
+    const body = document?.body;
+    if (!body) {
+      return undefined;
+    }
+
+    const ignoredNodeNames = new Set([
+        'SCRIPT', 'STYLE', 'NOSCRIPT', 'TEMPLATE', 'IFRAME', 'OBJECT',
+        'CANVAS', 'SVG', 'VIDEO', 'AUDIO', 'SELECT']);
+    const inlineDisplays = new Set(['inline', 'contents']);
+
+    let text = '';
+    const addLineBreak = () => {
+      if (text.length > 0 && !text.endsWith('\n')) {
+        text += '\n';
+      }
+    };
+
+    // Block elements enclosing the current node, used to add a line break
+    // when leaving them
+    const blocks = [];
+    const leaveBlocksNotContaining = (node) => {
+      let hasLeftBlock = false;
+      while (blocks.length > 0 && !blocks[blocks.length - 1].contains(node)) {
+        blocks.pop();
+        hasLeftBlock = true;
+      }
+      if (hasLeftBlock) {
+        addLineBreak();
+      }
+    };
+
+    const walker = document.createTreeWalker(body,
+        NodeFilter.SHOW_ELEMENT | NodeFilter.SHOW_TEXT, {
+      acceptNode(node) {
+        if (node.nodeType === Node.TEXT_NODE) {
+          return NodeFilter.FILTER_ACCEPT;
+        }
+
+        if (ignoredNodeNames.has(node.nodeName.toUpperCase()) ||
+            node.hidden) {
+          return NodeFilter.FILTER_REJECT;
+        }
+
+        if (node.nodeName.toUpperCase() === 'BR') {
+          addLineBreak();
+          return NodeFilter.FILTER_REJECT;
+        }
+
+        const style = getComputedStyle(node);
+        if (style.display === 'none') {
+          return NodeFilter.FILTER_REJECT;
+        }
+
+        if (!inlineDisplays.has(style.display)) {
+          leaveBlocksNotContaining(node);
+          blocks.push(node);
+          addLineBreak();
+        }
+
+        return NodeFilter.FILTER_SKIP;
+      }
+    });
+
+    while (text.length < maxLength && walker.nextNode()) {
+      const node = walker.currentNode;
+      leaveBlocksNotContaining(node);
+      if (node.parentElement &&
+          getComputedStyle(node.parentElement).visibility !== 'visible') {
+        continue;
+      }
+
+      text += node.nodeValue;
+    }
+
+    return text.substring(0, maxLength);
+  })()
+)";
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(sessions::SessionTabHelper::IdForTab(web_contents)),
@@ -34,6 +132,7 @@ AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
       is_active_(false),
       is_browser_active_(true),
       should_process_(false),
+      should_extract_text_when_visible_(false),
       weak_factory_(this) {
   if (!tab_id_.is_valid()) {
     return;
@@ -65,17 +164,54 @@ void AdsTabHelper::TabUpdated() {
                              is_active_, is_browser_active_);
 }
 
+bool AdsTabHelper::IsSearchResultsPage() const {
+  Profile* profile =
+      Profile::FromBrowserContext(web_contents()->GetBrowserContext());
+  TemplateURLService* template_url_service =
+      TemplateURLServiceFactory::GetForProfile(profile);
+  if (!template_url_service) {
+    return false;
+  }
+
+  return template_url_service->IsSearchResultsPageFromDefaultSearchProvider(
+      web_contents()->GetLastCommittedURL());
+}
+
 void AdsTabHelper::RunIsolatedJavaScript(
     content::RenderFrameHost* render_frame_host) {
   DCHECK(render_frame_host);
 
+  if (!ads_service_ || !ads_service_->IsEnabled()) {
+    return;
+  }
+
   dom_distiller::RunIsolatedJavaScript(
       render_frame_host, "new XMLSerializer().serializeToString(document)",
       base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
                      weak_factory_.GetWeakPtr()));
 
+  should_extract_text_when_visible_ = false;
+
+  if (IsSearchResultsPage()) {
+    // Search results pages are not classified, but purchase intent is still
+    // processed for the visited URL
+    ads_service_->OnTextLoaded(tab_id_, redirect_chain_, "");
+    return;
+  }
+
+  if (!is_active_) {
+    should_extract_text_when_visible_ = true;
+    return;
+  }
+
+  ExtractText(render_frame_host);
+}
+
+void AdsTabHelper::ExtractText(content::RenderFrameHost* render_frame_host) {
+  DCHECK(render_frame_host);
+
   dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "document?.body?.innerText",
+      render_frame_host, base::StringPrintf(kExtractTextScript, kMaxTextLength),
       base::BindOnce(&AdsTabHelper::OnJavaScriptTextResult,
                      weak_factory_.GetWeakPtr()));
 }
@@ -126,6 +262,8 @@ void AdsTabHelper::DidFinishNavigation(
 
   redirect_chain_ = navigation_handle->GetRedirectChain();
 
+  should_extract_text_when_visible_ = false;
+
   if (!navigation_handle->IsSameDocument()) {
     should_process_ = navigation_handle->GetRestoreType() ==
                       content::RestoreType::kNotRestored;
@@ -203,6 +341,11 @@ void AdsTabHelper::OnVisibilityChanged(content::Visibility visibility) {
   }
 
   TabUpdated();
+
+  if (is_active_ && should_extract_text_when_visible_) {
+    should_extract_text_when_visible_ = false;
+    ExtractText(web_contents()->GetMainFrame());
+  }
 }
 
 void AdsTabHelper::WebContentsDestroyed() {
@@ -57,8 +57,14 @@ class AdsTabHelper : public content::WebContentsObserver,
 
   void TabUpdated();
 
+  bool IsSearchResultsPage() const;
+
   void RunIsolatedJavaScript(content::RenderFrameHost* render_frame_host);
 
+  // Text is only extracted for visible tabs, so extraction for a tab loaded in
+  // the background is deferred until it becomes visible
+  void ExtractText(content::RenderFrameHost* render_frame_host);
+
   void OnJavaScriptHtmlResult(base::Value value);
 
   void OnJavaScriptTextResult(base::Value value);
@@ -91,6 +97,7 @@ class AdsTabHelper : public content::WebContentsObserver,
   bool is_browser_active_;
   std::vector<GURL> redirect_chain_;
   bool should_process_;
+  bool should_extract_text_when_visible_;
 
   base::WeakPtrFactory<AdsTabHelper> weak_factory_;
   WEB_CONTENTS_USER_DATA_KEY_DECL();
@@ -0,0 +1,344 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback_list.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "brave/browser/brave_ads/ads_service_factory.h"
+#include "brave/components/brave_ads/browser/ads_service.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/browser/search_engines/template_url_service_factory.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/search_test_utils.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "components/keyed_service/content/browser_context_dependency_manager.h"
+#include "components/network_session_configurator/common/network_switches.h"
+#include "components/search_engines/template_url.h"
+#include "components/search_engines/template_url_data.h"
+#include "components/search_engines/template_url_service.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/dns/mock_host_resolver.h"
+#include "net/http/http_status_code.h"
+#include "net/test/embedded_test_server/http_request.h"
+#include "net/test/embedded_test_server/http_response.h"
+#include "testing/gmock/include/gmock/gmock.h"
+
+// npm run test -- brave_browser_tests --filter=AdsTabHelperBrowserTest.*
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace brave_ads {
+
+namespace {
+
+constexpr size_t kMaxTextLength = 256 * 1024;
+
+const char kTextPage[] =
+    "<html><body>"
+    "<div style=\"display:none\">hidden_text</div>"
+    "<p>visible <b>bold</b>er</p>"
+    "<span style=\"visibility:hidden\">invisible_text</span>"
+    "<script>var script_text;</script>"
+    "<style>.style_text {}</style>"
+    "<div>next_block</div>"
+    "</body></html>";
+
+class MockAdsService : public AdsService {
+ public:
+  MockAdsService() = default;
+  ~MockAdsService() override = default;
+
+  MOCK_CONST_METHOD0(IsSupportedLocale, bool());
+  MOCK_METHOD0(IsNewlySupportedLocale, bool());
+  MOCK_CONST_METHOD0(IsEnabled, bool());
+  MOCK_METHOD1(SetEnabled, void(const bool));
+  MOCK_METHOD1(SetAllowConversionTracking, void(const bool));
+  MOCK_CONST_METHOD0(GetAdsPerHour, int64_t());
+  MOCK_METHOD1(SetAdsPerHour, void(const int64_t));
+  MOCK_CONST_METHOD0(ShouldAllowAdsSubdivisionTargeting, bool());
+  MOCK_CONST_METHOD0(GetAdsSubdivisionTargetingCode, std::string());
+  MOCK_METHOD1(SetAdsSubdivisionTargetingCode, void(const std::string&));
+  MOCK_CONST_METHOD0(GetAutoDetectedAdsSubdivisionTargetingCode,
+                     std::string());
+  MOCK_METHOD1(SetAutoDetectedAdsSubdivisionTargetingCode,
+               void(const std::string&));
+  MOCK_METHOD1(OnShowAdNotification, void(const std::string&));
+  MOCK_METHOD2(OnCloseAdNotification, void(const std::string&, const bool));
+  MOCK_METHOD1(OnClickAdNotification, void(const std::string&));
+  MOCK_METHOD1(ChangeLocale, void(const std::string&));
+  MOCK_METHOD3(OnHtmlLoaded,
+               void(const SessionID&,
+                    const std::vector<GURL>&,
+                    const std::string&));
+  MOCK_METHOD3(OnTextLoaded,
+               void(const SessionID&,
+                    const std::vector<GURL>&,
+                    const std::string&));
+  MOCK_METHOD1(OnUserGesture, void(const int32_t));
+  MOCK_METHOD1(OnMediaStart, void(const SessionID&));
+  MOCK_METHOD1(OnMediaStop, void(const SessionID&));
+  MOCK_METHOD4(OnTabUpdated,
+               void(const SessionID&, const GURL&, const bool, const bool));
+  MOCK_METHOD1(OnTabClosed, void(const SessionID&));
+  MOCK_METHOD1(OnResourceComponentUpdated, void(const std::string&));
+  MOCK_METHOD3(OnNewTabPageAdEvent,
+               void(const std::string&,
+                    const std::string&,
+                    const ads::mojom::NewTabPageAdEventType));
+  MOCK_METHOD3(OnPromotedContentAdEvent,
+               void(const std::string&,
+                    const std::string&,
+                    const ads::mojom::PromotedContentAdEventType));
+  MOCK_METHOD2(GetInlineContentAd,
+               void(const std::string&, OnGetInlineContentAdCallback));
+  MOCK_METHOD3(OnInlineContentAdEvent,
+               void(const std::string&,
+                    const std::string&,
+                    const ads::mojom::InlineContentAdEventType));
+  MOCK_METHOD1(PurgeOrphanedAdEventsForType, void(const ads::mojom::AdType));
+  MOCK_METHOD0(ReconcileAdRewards, void());
+  MOCK_METHOD3(GetAdsHistory,
+               void(const uint64_t, const uint64_t, OnGetAdsHistoryCallback));
+  MOCK_METHOD1(GetAccountStatement, void(GetAccountStatementCallback));
+  MOCK_METHOD1(GetAdDiagnostics, void(GetAdDiagnosticsCallback));
+  MOCK_METHOD4(ToggleAdThumbUp,
+               void(const std::string&,
+                    const std::string&,
+                    const int,
+                    OnToggleAdThumbUpCallback));
+  MOCK_METHOD4(ToggleAdThumbDown,
+               void(const std::string&,
+                    const std::string&,
+                    const int,
+                    OnToggleAdThumbDownCallback));
+  MOCK_METHOD3(ToggleAdOptInAction,
+               void(const std::string&,
+                    const int,
+                    OnToggleAdOptInActionCallback));
+  MOCK_METHOD3(ToggleAdOptOutAction,
+               void(const std::string&,
+                    const int,
+                    OnToggleAdOptOutActionCallback));
+  MOCK_METHOD4(ToggleSaveAd,
+               void(const std::string&,
+                    const std::string&,
+                    const bool,
+                    OnToggleSaveAdCallback));
+  MOCK_METHOD4(ToggleFlagAd,
+               void(const std::string&,
+                    const std::string&,
+                    const bool,
+                    OnToggleFlagAdCallback));
+  MOCK_METHOD1(ResetAllState, void(const bool));
+};
+
+// Serves |kTextPage|, a search results page and synthetic documents of the
+// size in bytes given by the query of /large.html
+std::unique_ptr<net::test_server::HttpResponse> HandleRequest(
+    const net::test_server::HttpRequest& request) {
+  const GURL url = request.GetURL();
+  std::string content;
+  if (url.path_piece() == "/text.html") {
+    content = kTextPage;
+  } else if (url.path_piece() == "/search") {
+    content = "<html><body><p>search results</p></body></html>";
+  } else if (url.path_piece() == "/large.html") {
+    size_t size = 0;
+    if (!base::StringToSizeT(url.query_piece(), &size)) {
+      return nullptr;
+    }
+    const std::string paragraph = "<p>lorem ipsum dolor sit amet</p>";
+    content = "<html><body>";
+    content.reserve(size + paragraph.size());
+    while (content.size() < size) {
+      content += paragraph;
+    }
+    content += "</body></html>";
+  } else {
+    return nullptr;
+  }
+
+  auto http_response = std::make_unique<net::test_server::BasicHttpResponse>();
+  http_response->set_code(net::HTTP_OK);
+  http_response->set_content_type("text/html");
+  http_response->set_content(content);
+  return http_response;
+}
+
+}  // namespace
+
+class AdsTabHelperBrowserTest : public InProcessBrowserTest {
+ public:
+  AdsTabHelperBrowserTest() = default;
+
+  void SetUpInProcessBrowserTestFixture() override {
+    InProcessBrowserTest::SetUpInProcessBrowserTestFixture();
+    create_services_subscription_ =
+        BrowserContextDependencyManager::GetInstance()
+            ->RegisterCreateServicesCallbackForTesting(base::BindRepeating(
+                &AdsTabHelperBrowserTest::OnWillCreateBrowserContextServices,
+                base::Unretained(this)));
+  }
+
+  void SetUpCommandLine(base::CommandLine* command_line) override {
+    // HTTPS server only serves a valid cert for localhost, so this is needed
+    // to load pages from other hosts without an error.
+    command_line->AppendSwitch(switches::kIgnoreCertificateErrors);
+  }
+
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+    host_resolver()->AddRule("*", "127.0.0.1");
+
+    https_server_ = std::make_unique<net::EmbeddedTestServer>(
+        net::test_server::EmbeddedTestServer::TYPE_HTTPS);
+    https_server_->SetSSLConfig(net::EmbeddedTestServer::CERT_OK);
+    https_server_->RegisterRequestHandler(base::BindRepeating(&HandleRequest));
+    ASSERT_TRUE(https_server_->Start());
+
+    ASSERT_TRUE(ads_service_);
+    ON_CALL(*ads_service_, IsEnabled()).WillByDefault(Return(true));
+  }
+
+  GURL GetURL(const std::string& path) {
+    return https_server_->GetURL("a.com", path);
+  }
+
+  // Navigates the active tab to |url| and returns the text passed to
+  // |OnTextLoaded|
+  std::string NavigateAndWaitForText(const GURL& url) {
+    std::string text;
+    base::RunLoop run_loop;
+    EXPECT_CALL(*ads_service_, OnTextLoaded(_, _, _))
+        .WillOnce(Invoke([&text, &run_loop](const SessionID& tab_id,
+                                            const std::vector<GURL>& chain,
+                                            const std::string& loaded_text) {
+          text = loaded_text;
+          run_loop.Quit();
+        }));
+
+    ui_test_utils::NavigateToURL(browser(), url);
+    run_loop.Run();
+    testing::Mock::VerifyAndClearExpectations(ads_service_);
+    ON_CALL(*ads_service_, IsEnabled()).WillByDefault(Return(true));
+    return text;
+  }
+
+  NiceMock<MockAdsService>* ads_service() { return ads_service_; }
+
+ private:
+  void OnWillCreateBrowserContextServices(content::BrowserContext* context) {
+    AdsServiceFactory::GetInstance()->SetTestingFactory(
+        context,
+        base::BindRepeating(&AdsTabHelperBrowserTest::BuildAdsService,
+                            base::Unretained(this)));
+  }
+
+  std::unique_ptr<KeyedService> BuildAdsService(
+      content::BrowserContext* context) {
+    auto ads_service = std::make_unique<NiceMock<MockAdsService>>();
+    ads_service_ = ads_service.get();
+    return ads_service;
+  }
+
+  NiceMock<MockAdsService>* ads_service_ = nullptr;  // NOT OWNED
+  std::unique_ptr<net::EmbeddedTestServer> https_server_;
+  base::CallbackListSubscription create_services_subscription_;
+};
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, ExtractRenderedText) {
+  // Text which isn't rendered is skipped and words split by inline elements
+  // stay whole
+  EXPECT_EQ("visible bolder\nnext_block",
+            NavigateAndWaitForText(GetURL("/text.html")));
+}
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, CapTextLength) {
+  const std::string text =
+      NavigateAndWaitForText(GetURL("/large.html?1048576"));
+  EXPECT_EQ(kMaxTextLength, text.size());
+}
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, CapTextLengthForHugeDocuments) {
+  for (const size_t size : {10 * 1024 * 1024, 50 * 1024 * 1024}) {
+    const std::string text = NavigateAndWaitForText(
+        GetURL("/large.html?" + base::NumberToString(size)));
+    EXPECT_EQ(kMaxTextLength, text.size());
+  }
+}
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, SkipSearchResultsPage) {
+  TemplateURLService* template_url_service =
+      TemplateURLServiceFactory::GetForProfile(browser()->profile());
+  search_test_utils::WaitForTemplateURLServiceToLoad(template_url_service);
+
+  TemplateURLData data;
+  data.SetShortName(u"test");
+  data.SetKeyword(u"test");
+  data.SetURL(GetURL("/search?q={searchTerms}").spec());
+  TemplateURL* template_url =
+      template_url_service->Add(std::make_unique<TemplateURL>(data));
+  template_url_service->SetUserSelectedDefaultSearchProvider(template_url);
+
+  // An empty text is sent so that purchase intent is still processed
+  EXPECT_EQ("", NavigateAndWaitForText(GetURL("/search?q=shoes")));
+}
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest,
+                       DeferTextExtractionForBackgroundTab) {
+  EXPECT_CALL(*ads_service(), OnTextLoaded(_, _, _)).Times(0);
+
+  ui_test_utils::NavigateToURLWithDisposition(
+      browser(), GetURL("/text.html"),
+      WindowOpenDisposition::NEW_BACKGROUND_TAB,
+      ui_test_utils::BROWSER_TEST_WAIT_FOR_LOAD_STOP);
+  TabStripModel* tab_strip_model = browser()->tab_strip_model();
+  ASSERT_EQ(2, tab_strip_model->count());
+  content::WebContents* background_contents =
+      tab_strip_model->GetWebContentsAt(1);
+  // Round trip to the renderer so that any extraction would have completed
+  ASSERT_TRUE(content::ExecJs(background_contents, "true"));
+  testing::Mock::VerifyAndClearExpectations(ads_service());
+  ON_CALL(*ads_service(), IsEnabled()).WillByDefault(Return(true));
+
+  std::string text;
+  base::RunLoop run_loop;
+  EXPECT_CALL(*ads_service(), OnTextLoaded(_, _, _))
+      .WillOnce(Invoke([&text, &run_loop](const SessionID& tab_id,
+                                          const std::vector<GURL>& chain,
+                                          const std::string& loaded_text) {
+        text = loaded_text;
+        run_loop.Quit();
+      }));
+
+  tab_strip_model->ActivateTabAt(1);
+  run_loop.Run();
+
+  EXPECT_EQ("visible bolder\nnext_block", text);
+}
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, SkipTextExtractionWhenDisabled) {
+  ON_CALL(*ads_service(), IsEnabled()).WillByDefault(Return(false));
+  EXPECT_CALL(*ads_service(), OnHtmlLoaded(_, _, _)).Times(0);
+  EXPECT_CALL(*ads_service(), OnTextLoaded(_, _, _)).Times(0);
+
+  ui_test_utils::NavigateToURL(browser(), GetURL("/text.html"));
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  ASSERT_TRUE(content::ExecJs(contents, "true"));
+}
+
+}  // namespace brave_ads
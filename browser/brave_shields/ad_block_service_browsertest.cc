@@ -36,6 +36,8 @@
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
 #include "extensions/test/extension_test_message_listener.h"
@@ -1716,3 +1718,72 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringIframeScriptlet) {
 
   ASSERT_EQ(true, EvalJs(contents, "show_ad"));
 }
+
+// Test that scriptlets and the pre-init script still run on a later
+// navigation in a renderer which already compiled them
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
+                       CosmeticFilteringScriptsRunOnSecondNavigation) {
+  brave_shields::SetCosmeticFilteringControlType(
+      content_settings(), brave_shields::ControlType::BLOCK, GURL());
+  std::string scriptlet =
+      "(function() {"
+      "  window.scriptletRunCount = (window.scriptletRunCount || 0) + 1;"
+      "})();";
+  std::string scriptlet_base64;
+  base::Base64Encode(scriptlet, &scriptlet_base64);
+  UpdateAdBlockInstanceWithRules(
+      "b.com##.fpsponsored\n"
+      "b.com##+js(cnt)",
+      "[{"
+      "\"name\": \"counttest\","
+      "\"aliases\": [\"cnt\"],"
+      "\"kind\": {\"mime\": \"application/javascript\"},"
+      "\"content\": \"" +
+          scriptlet_base64 + "\"}]");
+
+  WaitForBraveExtensionShieldsDataReady();
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  std::vector<int> process_ids;
+
+  for (const char* path :
+       {"/cosmetic_filtering.html", "/cosmetic_filtering.html?second"}) {
+    GURL tab_url = embedded_test_server()->GetURL("b.com", path);
+    ui_test_utils::NavigateToURL(browser(), tab_url);
+
+    process_ids.push_back(contents->GetMainFrame()->GetProcess()->GetID());
+
+    auto scriptlet_result = EvalJs(contents,
+                                   R"(function waitScriptlet() {
+          if (window.scriptletRunCount) {
+            window.domAutomationController.send(window.scriptletRunCount);
+          } else {
+            console.log('still waiting for scriptlet');
+            setTimeout(waitScriptlet, 200);
+          }
+        } waitScriptlet())",
+                                   content::EXECUTE_SCRIPT_USE_MANUAL_REPLY);
+    ASSERT_TRUE(scriptlet_result.error.empty());
+    EXPECT_EQ(base::Value(1), scriptlet_result.value);
+
+    // Hiding first party content relies on the flags set by the pre-init
+    // script.
+    auto result = EvalJs(contents,
+                         R"(function waitCSSSelector() {
+          if (checkSelector('.fpsponsored', 'display', 'none')) {
+            window.domAutomationController.send(true);
+          } else {
+            console.log('still waiting for css selector');
+            setTimeout(waitCSSSelector, 200);
+          }
+        } waitCSSSelector())",
+                         content::EXECUTE_SCRIPT_USE_MANUAL_REPLY);
+    ASSERT_TRUE(result.error.empty());
+    EXPECT_EQ(base::Value(true), result.value);
+  }
+
+  // Both navigations are same-site, so they share a renderer.
+  ASSERT_EQ(2u, process_ids.size());
+  EXPECT_EQ(process_ids[0], process_ids[1]);
+}
@@ -5,10 +5,13 @@
 
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_perf_predictor/browser/perf_predictor_tab_helper.h"
@@ -50,6 +53,9 @@ namespace {
 
 BraveShieldsWebContentsObserver* g_receiver_impl_for_testing = nullptr;
 
+constexpr base::TimeDelta kBlockedEventsFlushInterval =
+    base::TimeDelta::FromMilliseconds(100);
+
 // Content Settings are only sent to the main frame currently. Chrome may fix
 // this at some point, but for now we do this as a work-around. You can verify
 // if this is fixed by running the following test: npm run test --
@@ -195,21 +201,70 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
   }
   EventRouter* event_router =
       EventRouter::Get(web_contents->GetBrowserContext());
-  if (event_router) {
-    extensions::api::brave_shields::OnBlocked::Details details;
-    details.tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
-    details.block_type = block_type;
-    details.subresource = subresource;
-    std::unique_ptr<Event> event(
-        new Event(extensions::events::BRAVE_AD_BLOCKED,
-                  extensions::api::brave_shields::OnBlocked::kEventName,
-                  extensions::api::brave_shields::OnBlocked::Create(details)));
-    event_router->BroadcastEvent(std::move(event));
+  if (!event_router ||
+      !event_router->HasEventListener(
+          extensions::api::brave_shields::OnBlocked::kEventName)) {
+    return;
   }
+  BraveShieldsWebContentsObserver* observer =
+      BraveShieldsWebContentsObserver::FromWebContents(web_contents);
+  if (observer)
+    observer->AddPendingBlockedEvent(block_type, subresource);
 #endif
 }
 #endif
 
+void BraveShieldsWebContentsObserver::AddPendingBlockedEvent(
+    const std::string& block_type,
+    const std::string& subresource) {
+  auto it = std::find_if(
+      pending_blocked_events_.begin(), pending_blocked_events_.end(),
+      [&block_type](const auto& entry) { return entry.first == block_type; });
+  if (it == pending_blocked_events_.end()) {
+    pending_blocked_events_.emplace_back(block_type,
+                                         std::vector<std::string>());
+    it = std::prev(pending_blocked_events_.end());
+  }
+  it->second.push_back(subresource);
+
+  if (!blocked_events_timer_.IsRunning()) {
+    blocked_events_timer_.Start(
+        FROM_HERE, kBlockedEventsFlushInterval,
+        base::BindOnce(
+            &BraveShieldsWebContentsObserver::FlushPendingBlockedEvents,
+            base::Unretained(this)));
+  }
+}
+
+void BraveShieldsWebContentsObserver::FlushPendingBlockedEvents() {
+  blocked_events_timer_.Stop();
+  if (pending_blocked_events_.empty())
+    return;
+
+  auto pending_blocked_events = std::move(pending_blocked_events_);
+  pending_blocked_events_.clear();
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+  EventRouter* event_router =
+      EventRouter::Get(web_contents()->GetBrowserContext());
+  if (!event_router)
+    return;
+
+  extensions::api::brave_shields::OnBlocked::Details details;
+  details.tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents());
+  for (auto& entry : pending_blocked_events) {
+    extensions::api::brave_shields::BlockedResources blocked;
+    blocked.block_type = std::move(entry.first);
+    blocked.subresources = std::move(entry.second);
+    details.blocked.push_back(std::move(blocked));
+  }
+  std::unique_ptr<Event> event(
+      new Event(extensions::events::BRAVE_AD_BLOCKED,
+                extensions::api::brave_shields::OnBlocked::kEventName,
+                extensions::api::brave_shields::OnBlocked::Create(details)));
+  event_router->BroadcastEvent(std::move(event));
+#endif
+}
+
 void BraveShieldsWebContentsObserver::OnJavaScriptBlocked(
     const std::u16string& details) {
   WebContents* web_contents =
@@ -237,6 +292,9 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   content::ReloadType reload_type = navigation_handle->GetReloadType();
   if (navigation_handle->IsInMainFrame() &&
       !navigation_handle->IsSameDocument()) {
+    // Report everything blocked on the previous page before the extension
+    // sees the new one.
+    FlushPendingBlockedEvents();
     if (reload_type == content::ReloadType::NONE) {
       // For new loads, we reset the counters for both blocked scripts and URLs.
       allowed_script_origins_.clear();
@@ -256,6 +314,11 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   }
 }
 
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+  blocked_events_timer_.Stop();
+  pending_blocked_events_.clear();
+}
+
 void BraveShieldsWebContentsObserver::AllowScriptsOnce(
     const std::vector<std::string>& origins,
     WebContents* contents) {
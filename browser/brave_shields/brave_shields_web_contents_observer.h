@@ -9,11 +9,13 @@
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
+#include "base/timer/timer.h"
 #include "brave/components/brave_shields/common/brave_shields.mojom.h"
 #include "content/public/browser/render_frame_host_receiver_set.h"
 #include "content/public/browser/web_contents_observer.h"
@@ -62,6 +64,7 @@ class BraveShieldsWebContentsObserver
                               content::RenderFrameHost* new_host) override;
   void ReadyToCommitNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void WebContentsDestroyed() override;
 
   // brave_shields::mojom::BraveShieldsHost.
   void OnJavaScriptBlocked(const std::u16string& details) override;
@@ -90,6 +93,12 @@ class BraveShieldsWebContentsObserver
   mojo::AssociatedRemote<brave_shields::mojom::BraveShields>&
   GetBraveShieldsRemote(content::RenderFrameHost* rfh);
 
+  // Blocked subresources are reported to the Shields extension in batches, as
+  // ad-heavy pages block thousands of them per load.
+  void AddPendingBlockedEvent(const std::string& block_type,
+                              const std::string& subresource);
+  void FlushPendingBlockedEvents();
+
   std::vector<std::string> allowed_script_origins_;
   // We keep a set of the current page's blocked URLs in case the page
   // continually tries to load the same blocked URLs.
@@ -102,6 +111,12 @@ class BraveShieldsWebContentsObserver
   // interface, to prevent binding a new remote each time it's used.
   BraveShieldsRemotesMap brave_shields_remotes_;
 
+  // Subresources blocked since the last flush, grouped by block type in the
+  // order each type was first seen.
+  std::vector<std::pair<std::string, std::vector<std::string>>>
+      pending_blocked_events_;
+  base::OneShotTimer blocked_events_timer_;
+
   WEB_CONTENTS_USER_DATA_KEY_DECL();
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsWebContentsObserver);
 };
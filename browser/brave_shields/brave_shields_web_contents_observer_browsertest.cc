@@ -4,8 +4,12 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "base/path_service.h"
+#include "base/run_loop.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "brave/common/brave_paths.h"
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
+#include "brave/common/extensions/api/brave_shields.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/ui/browser.h"
@@ -18,6 +22,8 @@
 #include "content/public/browser/web_contents.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/event_router.h"
+#include "extensions/browser/test_event_router_observer.h"
 #include "net/dns/mock_host_resolver.h"
 #include "url/gurl.h"
 
@@ -92,6 +98,22 @@ class BraveShieldsWebContentsObserverBrowserTest : public InProcessBrowserTest {
     return brave_shields_web_contents_observer_;
   }
 
+  void DispatchBlockedEvent(const std::string& block_type,
+                            const std::string& subresource) {
+    BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
+        block_type, subresource, GetWebContents());
+  }
+
+  // Returns the "blocked" list of the last onBlocked event, if any.
+  const base::Value* GetLastBlockedList(
+      const extensions::TestEventRouterObserver& observer) {
+    auto it = observer.events().find(
+        extensions::api::brave_shields::OnBlocked::kEventName);
+    if (it == observer.events().end())
+      return nullptr;
+    return it->second->event_args->GetList()[0].FindListKey("blocked");
+  }
+
  private:
   HostContentSettingsMap* content_settings_;
   TestBraveShieldsWebContentsObserver* brave_shields_web_contents_observer_;
@@ -142,4 +164,56 @@ IN_PROC_BROWSER_TEST_F(BraveShieldsWebContentsObserverBrowserTest,
   EXPECT_EQ(brave_shields_web_contents_observer()->block_javascript_count(), 0);
 }
 
+IN_PROC_BROWSER_TEST_F(BraveShieldsWebContentsObserverBrowserTest,
+                       BlockedEventsAreBatched) {
+  EXPECT_TRUE(ui_test_utils::NavigateToURL(
+      browser(), embedded_test_server()->GetURL("a.com", "/simple.html")));
+
+  extensions::EventRouter* event_router =
+      extensions::EventRouter::Get(browser()->profile());
+  extensions::TestEventRouterObserver event_observer(event_router);
+  event_router->AddLazyEventListener(
+      extensions::api::brave_shields::OnBlocked::kEventName, "test");
+
+  DispatchBlockedEvent(kAds, "https://a.com/ad1.js");
+  DispatchBlockedEvent(kJavaScript, "https://a.com/script.js");
+  DispatchBlockedEvent(kAds, "https://a.com/ad2.js");
+  EXPECT_FALSE(GetLastBlockedList(event_observer));
+
+  // Everything blocked within the interval arrives as one event, grouped by
+  // block type in the order each type was first blocked.
+  base::RunLoop run_loop;
+  base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE, run_loop.QuitClosure(),
+      base::TimeDelta::FromMilliseconds(500));
+  run_loop.Run();
+  const base::Value* blocked = GetLastBlockedList(event_observer);
+  ASSERT_TRUE(blocked);
+  ASSERT_EQ(2u, blocked->GetList().size());
+  EXPECT_EQ(kAds, *blocked->GetList()[0].FindStringKey("blockType"));
+  EXPECT_EQ(base::Value(base::Value::ListStorage{
+                base::Value("https://a.com/ad1.js"),
+                base::Value("https://a.com/ad2.js")}),
+            *blocked->GetList()[0].FindListKey("subresources"));
+  EXPECT_EQ(kJavaScript, *blocked->GetList()[1].FindStringKey("blockType"));
+  EXPECT_EQ(1u,
+            blocked->GetList()[1].FindListKey("subresources")->GetList().size());
+
+  // Navigating away flushes pending events right away.
+  event_observer.ClearEvents();
+  DispatchBlockedEvent(kAds, "https://a.com/ad3.js");
+  EXPECT_TRUE(ui_test_utils::NavigateToURL(
+      browser(), embedded_test_server()->GetURL("b.com", "/simple.html")));
+  blocked = GetLastBlockedList(event_observer);
+  ASSERT_TRUE(blocked);
+  ASSERT_EQ(1u, blocked->GetList().size());
+  EXPECT_EQ("https://a.com/ad3.js", blocked->GetList()[0]
+                                        .FindListKey("subresources")
+                                        ->GetList()[0]
+                                        .GetString());
+
+  event_router->RemoveLazyEventListener(
+      extensions::api::brave_shields::OnBlocked::kEventName, "test");
+}
+
 }  // namespace brave_shields
@@ -7,6 +7,7 @@
 
 #include "base/strings/utf_string_conversions.h"
 #include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -118,6 +119,45 @@ IN_PROC_BROWSER_TEST_F(DomainBlockTest, ShowInterstitial) {
   ASSERT_TRUE(IsShowingInterstitial());
 }
 
+IN_PROC_BROWSER_TEST_F(DomainBlockTest, AllowedNavigationsAreNotDeferred) {
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  GURL url = embedded_test_server()->GetURL("a.com", "/simple.html");
+  SetCosmeticFilteringControlType(content_settings(), ControlType::BLOCK, url);
+  base::HistogramTester histograms;
+
+  // Only the first navigation waits for the ad block engines.
+  NavigateTo(url);
+  NavigateTo(url);
+  NavigateTo(url);
+  ASSERT_FALSE(IsShowingInterstitial());
+  histograms.ExpectBucketCount("Brave.DomainBlock.Deferred", true, 1);
+  histograms.ExpectBucketCount("Brave.DomainBlock.Deferred", false, 2);
+  histograms.ExpectTotalCount("Brave.DomainBlock.ShouldBlock", 1);
+
+  // Updating the rules invalidates earlier results.
+  BlockDomainByURL(url);
+  NavigateTo(url);
+  ASSERT_TRUE(IsShowingInterstitial());
+  histograms.ExpectBucketCount("Brave.DomainBlock.Deferred", true, 2);
+}
+
+IN_PROC_BROWSER_TEST_F(DomainBlockTest,
+                       AllowedNavigationsAreNotSharedWithIncognito) {
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  GURL url = embedded_test_server()->GetURL("a.com", "/simple.html");
+  SetCosmeticFilteringControlType(content_settings(), ControlType::BLOCK, url);
+  base::HistogramTester histograms;
+
+  NavigateTo(url);
+  histograms.ExpectBucketCount("Brave.DomainBlock.Deferred", true, 1);
+
+  // The incognito profile doesn't see URLs allowed in the regular profile.
+  Browser* incognito_browser = CreateIncognitoBrowser();
+  ui_test_utils::NavigateToURL(incognito_browser, url);
+  histograms.ExpectBucketCount("Brave.DomainBlock.Deferred", true, 2);
+  histograms.ExpectBucketCount("Brave.DomainBlock.Deferred", false, 0);
+}
+
 IN_PROC_BROWSER_TEST_F(DomainBlockTest, ShowInterstitialAndProceed) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
   GURL url = embedded_test_server()->GetURL("a.com", "/simple.html");
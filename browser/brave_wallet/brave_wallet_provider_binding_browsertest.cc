@@ -0,0 +1,136 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "base/path_service.h"
+#include "base/test/scoped_feature_list.h"
+#include "brave/common/brave_paths.h"
+#include "brave/components/brave_wallet/common/features.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "components/network_session_configurator/common/network_switches.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/dns/mock_host_resolver.h"
+
+namespace {
+
+const char kEmbeddedTestServerDirectory[] = "brave-wallet";
+
+// Number of frames of brave_wallet_iframes.html, including the main frame,
+// in which the window.ethereum stub has been replaced, either by setting up
+// the provider or by an assignment. Reading the property descriptor doesn't
+// go through the stub.
+const char kCountReplacedStubsScript[] = R"(
+    [window, ...Array.from(frames)].filter(w => {
+      const descriptor = Object.getOwnPropertyDescriptor(w, 'ethereum');
+      return descriptor && 'value' in descriptor;
+    }).length)";
+
+}  // namespace
+
+class BraveWalletProviderBindingTest : public InProcessBrowserTest {
+ public:
+  BraveWalletProviderBindingTest() {
+    feature_list_.InitAndEnableFeature(
+        brave_wallet::features::kNativeBraveWalletFeature);
+  }
+
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+    host_resolver()->AddRule("*", "127.0.0.1");
+
+    https_server_.reset(new net::EmbeddedTestServer(
+        net::test_server::EmbeddedTestServer::TYPE_HTTPS));
+    https_server_->SetSSLConfig(net::EmbeddedTestServer::CERT_OK);
+
+    brave::RegisterPathProvider();
+    base::FilePath test_data_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    test_data_dir = test_data_dir.AppendASCII(kEmbeddedTestServerDirectory);
+    https_server_->ServeFilesFromDirectory(test_data_dir);
+
+    ASSERT_TRUE(https_server_->Start());
+  }
+
+  void SetUpCommandLine(base::CommandLine* command_line) override {
+    // HTTPS server only serves a valid cert for localhost, so this is needed
+    // to load pages from other hosts without an error.
+    command_line->AppendSwitch(switches::kIgnoreCertificateErrors);
+  }
+
+  content::WebContents* NavigateToIframesPage() {
+    GURL url = https_server_->GetURL("a.com", "/brave_wallet_iframes.html");
+    ui_test_utils::NavigateToURL(browser(), url);
+    content::WebContents* contents =
+        browser()->tab_strip_model()->GetActiveWebContents();
+    EXPECT_TRUE(WaitForLoadStop(contents));
+    return contents;
+  }
+
+ private:
+  std::unique_ptr<net::EmbeddedTestServer> https_server_;
+  base::test::ScopedFeatureList feature_list_;
+};
+
+IN_PROC_BROWSER_TEST_F(BraveWalletProviderBindingTest,
+                       ProviderIsNotSetUpUntilAccessed) {
+  content::WebContents* contents = NavigateToIframesPage();
+
+  EXPECT_EQ(0, EvalJs(contents, kCountReplacedStubsScript));
+  EXPECT_EQ(true,
+            EvalJs(contents, "[window, ...Array.from(frames)].every(w => "
+                             "typeof Object.getOwnPropertyDescriptor("
+                             "w, 'ethereum').get === 'function')"));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveWalletProviderBindingTest,
+                       AccessFromParentSetsUpProviderInIframe) {
+  content::WebContents* contents = NavigateToIframesPage();
+
+  // The provider must be created in the iframe's context and the provider
+  // script must run there, leaving the parent's stub untouched.
+  EXPECT_EQ(true, EvalJs(contents, R"(
+      (() => {
+        const ethereum = frames[0].ethereum;
+        return ethereum === frames[0].ethereum &&
+            Object.getPrototypeOf(ethereum) === frames[0].Object.prototype &&
+            typeof ethereum.on === 'function' &&
+            typeof Object.getOwnPropertyDescriptor(
+                window, 'ethereum').get === 'function';
+      })())"));
+  EXPECT_EQ(1, EvalJs(contents, kCountReplacedStubsScript));
+
+  EXPECT_EQ(true, EvalJs(contents, "typeof window.ethereum.on === 'function'"));
+  EXPECT_EQ(2, EvalJs(contents, kCountReplacedStubsScript));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveWalletProviderBindingTest,
+                       AssignmentFromParentReplacesIframeStub) {
+  content::WebContents* contents = NavigateToIframesPage();
+
+  EXPECT_EQ(true, EvalJs(contents, R"(
+      (() => {
+        frames[1].ethereum = 42;
+        return frames[1].ethereum === 42 &&
+            typeof Object.getOwnPropertyDescriptor(
+                window, 'ethereum').get === 'function';
+      })())"));
+  EXPECT_EQ(1, EvalJs(contents, kCountReplacedStubsScript));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveWalletProviderBindingTest,
+                       AccessAfterIframeIsRemoved) {
+  content::WebContents* contents = NavigateToIframesPage();
+
+  // The stub of a removed iframe's window outlives the frame and its handler.
+  EXPECT_EQ(true, EvalJs(contents, R"(
+      (() => {
+        const removed_window = frames[2];
+        document.querySelectorAll('iframe')[2].remove();
+        return removed_window.ethereum === undefined;
+      })())"));
+  EXPECT_EQ(0, EvalJs(contents, kCountReplacedStubsScript));
+}
@@ -115,3 +115,14 @@ void BraveExternalProcessImporterClient::OnCreditCardImportReady(
                                     decrypted_card_number,
                                     origin);
 }
+
+void BraveExternalProcessImporterClient::OnHistoryImportBatchReady(
+    const std::vector<ImporterURLRow>& history_rows,
+    int32_t visit_source,
+    OnHistoryImportBatchReadyCallback callback) {
+  if (!cancelled_) {
+    bridge_->SetHistoryItems(
+        history_rows, static_cast<importer::VisitSource>(visit_source));
+  }
+  std::move(callback).Run();
+}
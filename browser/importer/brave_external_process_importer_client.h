@@ -7,6 +7,7 @@
 #define BRAVE_BROWSER_IMPORTER_BRAVE_EXTERNAL_PROCESS_IMPORTER_CLIENT_H_
 
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "brave/common/importer/profile_import.mojom.h"
@@ -41,6 +42,10 @@ class BraveExternalProcessImporterClient
                                const std::u16string& expiration_year,
                                const std::u16string& decrypted_card_number,
                                const std::string& origin) override;
+  void OnHistoryImportBatchReady(
+      const std::vector<ImporterURLRow>& history_rows,
+      int32_t visit_source,
+      OnHistoryImportBatchReadyCallback callback) override;
 
  protected:
   ~BraveExternalProcessImporterClient() override;
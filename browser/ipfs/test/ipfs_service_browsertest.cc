@@ -48,6 +48,29 @@ std::string GetFileNameForText(const std::string& text,
   return filename;
 }
 
+// Builds an add response streamed by the node for a folder, with an entry for
+// every file followed by the entries for the folder and the wrapping directory.
+std::string GetFolderAddResponse(const std::string& folder,
+                                 size_t file_count,
+                                 bool include_folder) {
+  std::string response;
+  for (size_t i = 0; i < file_count; i++) {
+    response += base::StringPrintf(
+        R"({"Name":"%s/file_%zu","Hash":"QmFile%zu","Size":"16"})"
+        "\n",
+        folder.c_str(), i, i);
+  }
+  if (include_folder) {
+    response += base::StringPrintf(
+        R"({"Name":"%s","Hash":"QmYbK4SLa","Size":"567857"})"
+        "\n",
+        folder.c_str());
+  }
+  response += R"({"Name":"","Hash":"QmWrapper","Size":"567900"})"
+              "\n";
+  return response;
+}
+
 class FakeIpfsService : public ipfs::IpfsService {
  public:
   FakeIpfsService(
@@ -261,6 +284,21 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     return HandleImportRequests(expected_result, request);
   }
 
+  std::unique_ptr<net::test_server::HttpResponse> HandleStreamedImportRequests(
+      const std::string& add_response,
+      const net::test_server::HttpRequest& request) {
+    const GURL gurl = request.GetURL();
+    if (gurl.path_piece() == kImportAddPath) {
+      auto http_response =
+          std::make_unique<net::test_server::BasicHttpResponse>();
+      http_response->set_code(net::HTTP_OK);
+      http_response->set_content_type("application/json");
+      http_response->set_content(add_response);
+      return http_response;
+    }
+    return HandleImportRequests("{}", request);
+  }
+
   std::unique_ptr<net::test_server::HttpResponse> HandleImportRequests(
       const std::string& expected_response,
       const net::test_server::HttpRequest& request) {
@@ -596,6 +634,16 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     }
   }
 
+  void OnImportCompletedWithHash(const std::string& expected_hash,
+                                 const ipfs::ImportedData& data) {
+    EXPECT_EQ(data.hash, expected_hash);
+    EXPECT_EQ(data.size, 567857);
+    ASSERT_EQ(data.state, ipfs::IPFS_IMPORT_SUCCESS);
+    if (wait_for_request_) {
+      wait_for_request_->Quit();
+    }
+  }
+
   void OnImportCompletedFail(ipfs::ImportState expected,
                              const std::string& expected_filename,
                              const ipfs::ImportedData& data) {
@@ -1097,6 +1145,39 @@ IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportDirectoryToIpfsSuccess) {
   WaitForRequest();
 }
 
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest,
+                       ImportDirectoryToIpfsStreamedResponse) {
+  ResetTestServer(base::BindRepeating(
+      &IpfsServiceBrowserTest::HandleStreamedImportRequests,
+      base::Unretained(this),
+      GetFolderAddResponse("autoplay-whitelist-data", 100000, true)));
+  auto* folder = FILE_PATH_LITERAL("brave/test/data/autoplay-whitelist-data");
+  auto test_path = embedded_test_server()->GetFullPathFromSourceDirectory(
+      base::FilePath(folder));
+  ipfs_service()->ImportDirectoryToIpfs(
+      test_path, std::string(),
+      base::BindOnce(&IpfsServiceBrowserTest::OnImportCompletedWithHash,
+                     base::Unretained(this), "QmYbK4SLa"));
+  WaitForRequest();
+}
+
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest,
+                       ImportDirectoryToIpfsStreamedResponseWithoutEntry) {
+  ResetTestServer(base::BindRepeating(
+      &IpfsServiceBrowserTest::HandleStreamedImportRequests,
+      base::Unretained(this),
+      GetFolderAddResponse("autoplay-whitelist-data", 1000, false)));
+  auto* folder = FILE_PATH_LITERAL("brave/test/data/autoplay-whitelist-data");
+  auto test_path = embedded_test_server()->GetFullPathFromSourceDirectory(
+      base::FilePath(folder));
+  ipfs_service()->ImportDirectoryToIpfs(
+      test_path, std::string(),
+      base::BindOnce(&IpfsServiceBrowserTest::OnImportCompletedFail,
+                     base::Unretained(this), ipfs::IPFS_IMPORT_ERROR_ADD_FAILED,
+                     "autoplay-whitelist-data"));
+  WaitForRequest();
+}
+
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportAndPinDirectorySuccess) {
   std::string expected_response =
       R"({"Name":"autoplay-whitelist-data", "Size":"567857", "Hash": "QmYbK4SLa"})";
@@ -8,11 +8,9 @@
 #include <utility>
 #include <vector>
 
-#include "brave/browser/brave_wallet/rpc_controller_factory.h"
+#include "brave/browser/net/decentralized_dns_resolution_cache.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_call_data_builder.h"
-#include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
-#include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/decentralized_dns/constants.h"
 #include "brave/components/decentralized_dns/utils.h"
 #include "brave/components/ipfs/ipfs_utils.h"
@@ -38,48 +36,55 @@ int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
     return net::OK;
   }
 
-  auto pending =
-      brave_wallet::RpcControllerFactory::GetForContext(ctx->browser_context);
-
-  mojo::Remote<brave_wallet::mojom::EthJsonRpcController> rpc_controller;
-  rpc_controller.Bind(std::move(pending));
-
-  if (!rpc_controller)
+  // Only .crypto and .eth names resolved through Ethereum need the wallet
+  // service, so check that before anything else.
+  const bool is_unstoppable_domain =
+      IsUnstoppableDomainsTLD(ctx->request_url) &&
+      IsUnstoppableDomainsResolveMethodEthereum(
+          g_browser_process->local_state());
+  const bool is_ens_domain =
+      !is_unstoppable_domain && IsENSTLD(ctx->request_url) &&
+      IsENSResolveMethodEthereum(g_browser_process->local_state());
+  if (!is_unstoppable_domain && !is_ens_domain)
     return net::OK;
 
-  if (IsUnstoppableDomainsTLD(ctx->request_url) &&
-      IsUnstoppableDomainsResolveMethodEthereum(
-          g_browser_process->local_state())) {
+  std::string data;
+  if (is_unstoppable_domain) {
     auto keys = std::vector<std::string>(std::begin(kRecordKeys),
                                          std::end(kRecordKeys));
-    std::string data;
     if (!brave_wallet::unstoppable_domains::GetMany(
             keys, ctx->request_url.host(), &data))
       return net::OK;
-
-    rpc_controller->UnstoppableDomainsProxyReaderGetMany(
-        kProxyReaderContractAddress, ctx->request_url.host(), keys,
-        base::BindOnce(&OnBeforeURLRequest_DecentralizedDnsRedirectWork,
-                       next_callback, ctx));
-
-    return net::ERR_IO_PENDING;
+  } else if (!brave_wallet::ens::GetResolverAddress(ctx->request_url.host(),
+                                                    &data)) {
+    return net::OK;
   }
 
-  if (IsENSTLD(ctx->request_url) &&
-      IsENSResolveMethodEthereum(g_browser_process->local_state())) {
-    std::string data;
-    if (!brave_wallet::ens::GetResolverAddress(ctx->request_url.host(), &data))
-      return net::OK;
-
-    rpc_controller->EnsProxyReaderGetResolverAddress(
-        kEnsRegistryContractAddress, ctx->request_url.host(),
-        base::BindOnce(&OnBeforeURLRequest_EnsRedirectWork, next_callback,
-                       ctx));
-
-    return net::ERR_IO_PENDING;
+  auto* cache =
+      DecentralizedDnsResolutionCache::GetForContext(ctx->browser_context);
+  absl::optional<std::string> cached_result =
+      cache->GetCachedResult(ctx->request_url);
+  if (cached_result) {
+    if (is_unstoppable_domain) {
+      OnBeforeURLRequest_DecentralizedDnsRedirectWork(
+          brave::ResponseCallback(), ctx, true, *cached_result);
+    } else {
+      OnBeforeURLRequest_EnsRedirectWork(brave::ResponseCallback(), ctx, true,
+                                         *cached_result);
+    }
+    return net::OK;
   }
 
-  return net::OK;
+  auto callback =
+      is_unstoppable_domain
+          ? base::BindOnce(&OnBeforeURLRequest_DecentralizedDnsRedirectWork,
+                           next_callback, ctx)
+          : base::BindOnce(&OnBeforeURLRequest_EnsRedirectWork, next_callback,
+                           ctx);
+  if (!cache->Resolve(ctx->request_url, std::move(callback)))
+    return net::OK;
+
+  return net::ERR_IO_PENDING;
 }
 
 void OnBeforeURLRequest_EnsRedirectWork(
@@ -6,9 +6,15 @@
 #include "brave/browser/net/decentralized_dns_network_delegate_helper.h"
 
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "base/test/bind.h"
 #include "base/test/scoped_feature_list.h"
+#include "brave/browser/net/decentralized_dns_resolution_cache.h"
 #include "brave/browser/net/url_context.h"
+#include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/decentralized_dns/constants.h"
 #include "brave/components/decentralized_dns/features.h"
 #include "brave/components/decentralized_dns/pref_names.h"
@@ -18,6 +24,7 @@
 #include "chrome/test/base/testing_profile.h"
 #include "components/prefs/testing_pref_service.h"
 #include "content/public/test/browser_task_environment.h"
+#include "mojo/public/cpp/bindings/receiver.h"
 #include "net/base/net_errors.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
@@ -26,6 +33,100 @@ using brave::ResponseCallback;
 
 namespace decentralized_dns {
 
+namespace {
+
+// Records decentralized DNS lookups and lets the test decide when to reply.
+class FakeEthJsonRpcController
+    : public brave_wallet::mojom::EthJsonRpcController {
+ public:
+  using LookupCallback = base::OnceCallback<void(bool, const std::string&)>;
+
+  FakeEthJsonRpcController() = default;
+  ~FakeEthJsonRpcController() override = default;
+
+  mojo::PendingRemote<brave_wallet::mojom::EthJsonRpcController> MakeRemote() {
+    return receiver_.BindNewPipeAndPassRemote();
+  }
+
+  void Reply(bool success, const std::string& result) {
+    auto callbacks = std::move(pending_callbacks_);
+    for (auto& callback : callbacks)
+      std::move(callback).Run(success, result);
+  }
+
+  size_t lookup_count() const { return lookup_count_; }
+
+  // brave_wallet::mojom::EthJsonRpcController:
+  void UnstoppableDomainsProxyReaderGetMany(
+      const std::string& contract_address,
+      const std::string& domain,
+      const std::vector<std::string>& keys,
+      UnstoppableDomainsProxyReaderGetManyCallback callback) override {
+    ++lookup_count_;
+    pending_callbacks_.push_back(std::move(callback));
+  }
+  void EnsProxyReaderGetResolverAddress(
+      const std::string& contract_address,
+      const std::string& domain,
+      EnsProxyReaderGetResolverAddressCallback callback) override {
+    ++lookup_count_;
+    pending_callbacks_.push_back(std::move(callback));
+  }
+  void SetNetwork(brave_wallet::mojom::Network network) override {}
+  void GetNetwork(GetNetworkCallback callback) override {}
+  void GetChainId(GetChainIdCallback callback) override {}
+  void GetBlockTrackerUrl(GetBlockTrackerUrlCallback callback) override {}
+  void GetNetworkUrl(GetNetworkUrlCallback callback) override {}
+  void GetBalance(const std::string& address,
+                  GetBalanceCallback callback) override {}
+  void GetERC20TokenBalance(const std::string& contract,
+                            const std::string& address,
+                            GetERC20TokenBalanceCallback callback) override {}
+  void Request(const std::string& json_payload,
+               bool auto_retry_on_network_change,
+               RequestCallback callback) override {}
+  void AddObserver(
+      mojo::PendingRemote<brave_wallet::mojom::EthJsonRpcControllerObserver>
+          observer) override {}
+  void SetCustomNetwork(const GURL& provider_url) override {}
+
+ private:
+  mojo::Receiver<brave_wallet::mojom::EthJsonRpcController> receiver_{this};
+  std::vector<LookupCallback> pending_callbacks_;
+  size_t lookup_count_ = 0;
+};
+
+// eth_call result of getMany() with only dweb.ipfs.hash set.
+constexpr char kIpfsHashResult[] =
+    // offset for array
+    "0x0000000000000000000000000000000000000000000000000000000000000020"
+    // count for array
+    "0000000000000000000000000000000000000000000000000000000000000006"
+    // offsets for array elements
+    "00000000000000000000000000000000000000000000000000000000000000c0"
+    "0000000000000000000000000000000000000000000000000000000000000120"
+    "0000000000000000000000000000000000000000000000000000000000000140"
+    "0000000000000000000000000000000000000000000000000000000000000160"
+    "0000000000000000000000000000000000000000000000000000000000000180"
+    "00000000000000000000000000000000000000000000000000000000000001a0"
+    // count for "QmWrdNJWMbvRxxzLhojVKaBDswS4KNVM7LvjsN7QbDrvka"
+    "000000000000000000000000000000000000000000000000000000000000002e"
+    // encoding for "QmWrdNJWMbvRxxzLhojVKaBDswS4KNVM7LvjsN7QbDrvka"
+    "516d5772644e4a574d62765278787a4c686f6a564b614244737753344b4e564d"
+    "374c766a734e3751624472766b61000000000000000000000000000000000000"
+    // count for empty ipfs.html.value
+    "0000000000000000000000000000000000000000000000000000000000000000"
+    // count for empty dns.A
+    "0000000000000000000000000000000000000000000000000000000000000000"
+    // count for empty dns.AAAA
+    "0000000000000000000000000000000000000000000000000000000000000000"
+    // count for empty browser.redirect_url
+    "0000000000000000000000000000000000000000000000000000000000000000"
+    // count for empty ipfs.redirect_domain.value
+    "0000000000000000000000000000000000000000000000000000000000000000";
+
+}  // namespace
+
 class DecentralizedDnsNetworkDelegateHelperTest : public testing::Test {
  public:
   DecentralizedDnsNetworkDelegateHelperTest()
@@ -47,8 +148,11 @@ class DecentralizedDnsNetworkDelegateHelperTest : public testing::Test {
   TestingProfile* profile() { return profile_.get(); }
   PrefService* local_state() { return local_state_->Get(); }
 
+ protected:
+  content::BrowserTaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+
  private:
-  content::BrowserTaskEnvironment task_environment_;
   std::unique_ptr<TestingProfile> profile_;
   std::unique_ptr<ScopedTestingLocalState> local_state_;
   base::test::ScopedFeatureList feature_list_;
@@ -302,4 +406,99 @@ TEST_F(DecentralizedDnsNetworkDelegateHelperTest, EnsRedirectWork) {
       "ipns://bafybeihqoo7bq7uoaybzpfwegks33vw2h5adyl4t7joz3pofkr6h7yhdxq");
 }
 
+TEST_F(DecentralizedDnsNetworkDelegateHelperTest,
+       OtherTLDsDoNotReachWalletService) {
+  local_state()->SetInteger(kUnstoppableDomainsResolveMethod,
+                            static_cast<int>(ResolveMethodTypes::ETHEREUM));
+  FakeEthJsonRpcController rpc_controller;
+  DecentralizedDnsResolutionCache::GetForContext(profile())
+      ->SetRpcControllerForTesting(rpc_controller.MakeRemote());
+
+  auto brave_request_info =
+      std::make_shared<brave::BraveRequestInfo>(GURL("https://brave.com"));
+  brave_request_info->browser_context = profile();
+  EXPECT_EQ(net::OK, OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
+                         ResponseCallback(), brave_request_info));
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(0u, rpc_controller.lookup_count());
+}
+
+TEST_F(DecentralizedDnsNetworkDelegateHelperTest, ResolutionsAreCached) {
+  local_state()->SetInteger(kUnstoppableDomainsResolveMethod,
+                            static_cast<int>(ResolveMethodTypes::ETHEREUM));
+  FakeEthJsonRpcController rpc_controller;
+  DecentralizedDnsResolutionCache::GetForContext(profile())
+      ->SetRpcControllerForTesting(rpc_controller.MakeRemote());
+
+  int callback_count = 0;
+  auto next_callback =
+      base::BindLambdaForTesting([&callback_count]() { ++callback_count; });
+  auto make_request = [&](const std::string& spec) {
+    auto request_info = std::make_shared<brave::BraveRequestInfo>(GURL(spec));
+    request_info->browser_context = profile();
+    return request_info;
+  };
+
+  // Concurrent requests for the same name share one lookup.
+  auto first = make_request("http://brave.crypto");
+  auto second = make_request("http://brave.crypto/image.png");
+  EXPECT_EQ(net::ERR_IO_PENDING,
+            OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(next_callback,
+                                                               first));
+  EXPECT_EQ(net::ERR_IO_PENDING,
+            OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(next_callback,
+                                                               second));
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(1u, rpc_controller.lookup_count());
+
+  rpc_controller.Reply(true, kIpfsHashResult);
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(2, callback_count);
+  EXPECT_EQ("ipfs://QmWrdNJWMbvRxxzLhojVKaBDswS4KNVM7LvjsN7QbDrvka",
+            first->new_url_spec);
+  EXPECT_EQ(first->new_url_spec, second->new_url_spec);
+
+  // Later requests are answered from the cache without waiting.
+  auto third = make_request("http://brave.crypto/style.css");
+  EXPECT_EQ(net::OK, OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
+                         next_callback, third));
+  EXPECT_EQ(first->new_url_spec, third->new_url_spec);
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(1u, rpc_controller.lookup_count());
+
+  // Until the cached result expires.
+  task_environment_.FastForwardBy(DecentralizedDnsResolutionCache::kResultTTL);
+  auto fourth = make_request("http://brave.crypto");
+  EXPECT_EQ(net::ERR_IO_PENDING,
+            OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(next_callback,
+                                                               fourth));
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(2u, rpc_controller.lookup_count());
+}
+
+TEST_F(DecentralizedDnsNetworkDelegateHelperTest, FailedResolutionsAreRetried) {
+  local_state()->SetInteger(kENSResolveMethod,
+                            static_cast<int>(ResolveMethodTypes::ETHEREUM));
+  FakeEthJsonRpcController rpc_controller;
+  DecentralizedDnsResolutionCache::GetForContext(profile())
+      ->SetRpcControllerForTesting(rpc_controller.MakeRemote());
+
+  auto brave_request_info =
+      std::make_shared<brave::BraveRequestInfo>(GURL("http://brave.eth"));
+  brave_request_info->browser_context = profile();
+  EXPECT_EQ(net::ERR_IO_PENDING,
+            OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
+                ResponseCallback(), brave_request_info));
+  task_environment_.RunUntilIdle();
+  rpc_controller.Reply(false, "");
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(brave_request_info->new_url_spec.empty());
+
+  EXPECT_EQ(net::ERR_IO_PENDING,
+            OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
+                ResponseCallback(), brave_request_info));
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(2u, rpc_controller.lookup_count());
+}
+
 }  // namespace decentralized_dns
@@ -0,0 +1,158 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/decentralized_dns_resolution_cache.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/notreached.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "brave/browser/brave_wallet/rpc_controller_factory.h"
+#include "brave/components/decentralized_dns/constants.h"
+#include "brave/components/decentralized_dns/utils.h"
+#include "content/public/browser/browser_context.h"
+#include "url/gurl.h"
+
+namespace decentralized_dns {
+
+namespace {
+
+const char kDecentralizedDnsResolutionCacheKey[] =
+    "decentralized_dns_resolution_cache";
+
+// Names are looked up once per page load at most, so a small cache is enough
+// to cover the hosts a profile is actively using.
+constexpr size_t kMaxCachedResults = 100;
+
+}  // namespace
+
+DecentralizedDnsResolutionCache::DecentralizedDnsResolutionCache(
+    content::BrowserContext* context)
+    : context_(context), results_(kMaxCachedResults) {}
+
+DecentralizedDnsResolutionCache::~DecentralizedDnsResolutionCache() = default;
+
+// static
+DecentralizedDnsResolutionCache* DecentralizedDnsResolutionCache::GetForContext(
+    content::BrowserContext* context) {
+  auto* cache = static_cast<DecentralizedDnsResolutionCache*>(
+      context->GetUserData(kDecentralizedDnsResolutionCacheKey));
+  if (!cache) {
+    auto new_cache = std::make_unique<DecentralizedDnsResolutionCache>(context);
+    cache = new_cache.get();
+    context->SetUserData(kDecentralizedDnsResolutionCacheKey,
+                         std::move(new_cache));
+  }
+  return cache;
+}
+
+absl::optional<std::string> DecentralizedDnsResolutionCache::GetCachedResult(
+    const GURL& url) {
+  auto it = results_.Get(url.host());
+  if (it == results_.end())
+    return absl::nullopt;
+
+  if (base::TimeTicks::Now() >= it->second.expiration) {
+    results_.Erase(it);
+    return absl::nullopt;
+  }
+  return it->second.result;
+}
+
+bool DecentralizedDnsResolutionCache::Resolve(const GURL& url,
+                                              ResolveCallback callback) {
+  const std::string host = url.host();
+  auto pending = pending_lookups_.find(host);
+  if (pending != pending_lookups_.end()) {
+    pending->second.push_back(std::move(callback));
+    return true;
+  }
+
+  auto* rpc_controller = GetRpcController();
+  if (!rpc_controller)
+    return false;
+
+  auto on_resolved =
+      base::BindOnce(&DecentralizedDnsResolutionCache::OnResolved,
+                     weak_ptr_factory_.GetWeakPtr(), host);
+  if (IsUnstoppableDomainsTLD(url)) {
+    rpc_controller->UnstoppableDomainsProxyReaderGetMany(
+        kProxyReaderContractAddress, host,
+        std::vector<std::string>(std::begin(kRecordKeys),
+                                 std::end(kRecordKeys)),
+        std::move(on_resolved));
+  } else if (IsENSTLD(url)) {
+    rpc_controller->EnsProxyReaderGetResolverAddress(
+        kEnsRegistryContractAddress, host, std::move(on_resolved));
+  } else {
+    NOTREACHED();
+    return false;
+  }
+
+  pending_lookups_[host].push_back(std::move(callback));
+  return true;
+}
+
+void DecentralizedDnsResolutionCache::SetRpcControllerForTesting(
+    mojo::PendingRemote<brave_wallet::mojom::EthJsonRpcController>
+        rpc_controller) {
+  rpc_controller_.reset();
+  rpc_controller_.Bind(std::move(rpc_controller));
+  rpc_controller_.set_disconnect_handler(base::BindOnce(
+      &DecentralizedDnsResolutionCache::OnRpcControllerDisconnected,
+      base::Unretained(this)));
+}
+
+brave_wallet::mojom::EthJsonRpcController*
+DecentralizedDnsResolutionCache::GetRpcController() {
+  if (rpc_controller_)
+    return rpc_controller_.get();
+
+  auto pending = brave_wallet::RpcControllerFactory::GetForContext(context_);
+  if (!pending)
+    return nullptr;
+
+  rpc_controller_.Bind(std::move(pending));
+  rpc_controller_.set_disconnect_handler(base::BindOnce(
+      &DecentralizedDnsResolutionCache::OnRpcControllerDisconnected,
+      base::Unretained(this)));
+  return rpc_controller_.get();
+}
+
+void DecentralizedDnsResolutionCache::OnResolved(const std::string& host,
+                                                 bool success,
+                                                 const std::string& result) {
+  // Failures aren't cached so that the next request tries again.
+  if (success) {
+    results_.Put(host, {result, base::TimeTicks::Now() + kResultTTL});
+  }
+
+  auto pending = pending_lookups_.find(host);
+  if (pending == pending_lookups_.end())
+    return;
+  std::vector<ResolveCallback> callbacks = std::move(pending->second);
+  pending_lookups_.erase(pending);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(success, result);
+}
+
+void DecentralizedDnsResolutionCache::OnRpcControllerDisconnected() {
+  rpc_controller_.reset();
+
+  // Replies to in-flight lookups are dropped along with the pipe, so fail
+  // them here rather than leaving their requests waiting forever.
+  auto pending_lookups = std::move(pending_lookups_);
+  pending_lookups_.clear();
+  for (auto& pending : pending_lookups) {
+    for (auto& callback : pending.second) {
+      base::SequencedTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE, base::BindOnce(std::move(callback), false, std::string()));
+    }
+  }
+}
+
+}  // namespace decentralized_dns
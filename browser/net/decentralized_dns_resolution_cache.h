@@ -0,0 +1,90 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_DECENTRALIZED_DNS_RESOLUTION_CACHE_H_
+#define BRAVE_BROWSER_NET_DECENTRALIZED_DNS_RESOLUTION_CACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/supports_user_data.h"
+#include "base/time/time.h"
+#include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+class GURL;
+
+namespace content {
+class BrowserContext;
+}
+
+namespace decentralized_dns {
+
+// Per-profile cache of the eth_call results used to resolve .crypto and .eth
+// names. Successful results are kept for |kResultTTL| so that subresources on
+// the same host don't query the chain again, and concurrent lookups of the
+// same name share a single eth_call.
+class DecentralizedDnsResolutionCache : public base::SupportsUserData::Data {
+ public:
+  using ResolveCallback =
+      base::OnceCallback<void(bool success, const std::string& result)>;
+
+  static constexpr base::TimeDelta kResultTTL =
+      base::TimeDelta::FromMinutes(5);
+
+  explicit DecentralizedDnsResolutionCache(content::BrowserContext* context);
+  ~DecentralizedDnsResolutionCache() override;
+
+  static DecentralizedDnsResolutionCache* GetForContext(
+      content::BrowserContext* context);
+
+  // Returns the raw eth_call result for |url|'s host if a lookup succeeded
+  // within the last |kResultTTL|.
+  absl::optional<std::string> GetCachedResult(const GURL& url);
+
+  // Queries the records of |url|'s host, which must be a .crypto or .eth
+  // name. |callback| is always run asynchronously. Returns false, without
+  // running |callback|, if the wallet service isn't available.
+  bool Resolve(const GURL& url, ResolveCallback callback);
+
+  void SetRpcControllerForTesting(
+      mojo::PendingRemote<brave_wallet::mojom::EthJsonRpcController>
+          rpc_controller);
+
+ private:
+  struct CachedResult {
+    std::string result;
+    base::TimeTicks expiration;
+  };
+
+  brave_wallet::mojom::EthJsonRpcController* GetRpcController();
+  void OnResolved(const std::string& host,
+                  bool success,
+                  const std::string& result);
+  void OnRpcControllerDisconnected();
+
+  content::BrowserContext* const context_;  // Not owned.
+  mojo::Remote<brave_wallet::mojom::EthJsonRpcController> rpc_controller_;
+
+  base::MRUCache<std::string, CachedResult> results_;
+  // Callbacks waiting on an in-flight lookup, keyed by host.
+  std::map<std::string, std::vector<ResolveCallback>> pending_lookups_;
+
+  base::WeakPtrFactory<DecentralizedDnsResolutionCache> weak_ptr_factory_{
+      this};
+
+  DISALLOW_COPY_AND_ASSIGN(DecentralizedDnsResolutionCache);
+};
+
+}  // namespace decentralized_dns
+
+#endif  // BRAVE_BROWSER_NET_DECENTRALIZED_DNS_RESOLUTION_CACHE_H_
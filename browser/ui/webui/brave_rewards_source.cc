@@ -5,18 +5,24 @@
 
 #include "brave/browser/ui/webui/brave_rewards_source.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
-#include "base/memory/ref_counted_memory.h"
-#include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service.h"
+#include "base/bind.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "ui/gfx/codec/png_codec.h"
-#include "url/gurl.h"
 
 namespace {
 
+// Number of encoded images kept in memory.
+constexpr size_t kMemoryCacheSize = 128;
+
+// Cached images older than this are fetched again.
+constexpr base::TimeDelta kCacheTTL = base::TimeDelta::FromDays(1);
+
 scoped_refptr<base::RefCountedMemory> BitmapToMemory(const SkBitmap* image) {
   base::RefCountedBytes* image_bytes = new base::RefCountedBytes;
   gfx::PNGCodec::EncodeBGRASkBitmap(*image, false, &image_bytes->data());
@@ -26,7 +32,8 @@ scoped_refptr<base::RefCountedMemory> BitmapToMemory(const SkBitmap* image) {
 }  // namespace
 
 BraveRewardsSource::BraveRewardsSource(Profile* profile)
-    : profile_(profile->GetOriginalProfile()) {}
+    : profile_(profile->GetOriginalProfile()),
+      memory_cache_(kMemoryCacheSize) {}
 
 BraveRewardsSource::~BraveRewardsSource() {
 }
@@ -48,44 +55,56 @@ void BraveRewardsSource::StartDataRequest(
     return;
   }
 
-  auto it =
-      find(resource_fetchers_.begin(), resource_fetchers_.end(), actual_url);
-  if (it != resource_fetchers_.end()) {
-    LOG(WARNING) << "Already fetching specified Brave Rewards resource, url: "
-                 << actual_url;
-    return;
+  auto cached = memory_cache_.Get(actual_url);
+  if (cached != memory_cache_.end()) {
+    if (base::Time::Now() - cached->second.fetched_at <= kCacheTTL) {
+      std::move(got_data_callback).Run(cached->second.data);
+      return;
+    }
+    memory_cache_.Erase(cached);
   }
 
+  // Requests for an image which is already being loaded wait for that load.
+  auto& callbacks = pending_requests_[actual_url];
+  callbacks.push_back(std::move(got_data_callback));
+  if (callbacks.size() > 1)
+    return;
+
+  FetchBitmap(actual_url,
+              base::BindOnce(&BraveRewardsSource::OnBitmapFetched,
+                             weak_factory_.GetWeakPtr(), actual_url));
+}
+
+void BraveRewardsSource::FetchBitmap(
+    const GURL& url,
+    BitmapFetcherService::BitmapFetchedCallback callback) {
   BitmapFetcherService* image_service =
       BitmapFetcherServiceFactory::GetForBrowserContext(profile_);
-  if (image_service) {
-    net::NetworkTrafficAnnotationTag traffic_annotation =
-        net::DefineNetworkTrafficAnnotation("brave_rewards_resource_fetcher", R"(
-        semantics {
-          sender:
-            "Brave Rewards resource fetcher"
-          description:
-            "Fetches resources related to Brave Rewards."
-          trigger:
-            "User visits a media publisher's site."
-          data: "Brave Rewards related resources."
-          destination: WEBSITE
-        }
-        policy {
-          cookies_allowed: NO
-          setting:
-            "This feature cannot be disabled by settings."
-          policy_exception_justification:
-            "Not implemented."
-        })");
-    resource_fetchers_.emplace_back(actual_url);
-    image_service->RequestImage(
-        actual_url,
-        base::BindOnce(&BraveRewardsSource::OnBitmapFetched,
-                       weak_factory_.GetWeakPtr(), std::move(got_data_callback),
-                       actual_url),
-        traffic_annotation);
+  if (!image_service) {
+    std::move(callback).Run(SkBitmap());
+    return;
   }
+
+  net::NetworkTrafficAnnotationTag traffic_annotation =
+      net::DefineNetworkTrafficAnnotation("brave_rewards_resource_fetcher", R"(
+      semantics {
+        sender:
+          "Brave Rewards resource fetcher"
+        description:
+          "Fetches resources related to Brave Rewards."
+        trigger:
+          "User visits a media publisher's site."
+        data: "Brave Rewards related resources."
+        destination: WEBSITE
+      }
+      policy {
+        cookies_allowed: NO
+        setting:
+          "This feature cannot be disabled by settings."
+        policy_exception_justification:
+          "Not implemented."
+      })");
+  image_service->RequestImage(url, std::move(callback), traffic_annotation);
 }
 
 std::string BraveRewardsSource::GetMimeType(const std::string&) {
@@ -112,21 +131,28 @@ bool BraveRewardsSource::ShouldServiceRequest(
                                              render_process_id);
 }
 
-void BraveRewardsSource::OnBitmapFetched(
-    content::URLDataSource::GotDataCallback got_data_callback,
-    const GURL& url,
-    const SkBitmap& bitmap) {
+void BraveRewardsSource::OnBitmapFetched(const GURL& url,
+                                         const SkBitmap& bitmap) {
   if (bitmap.isNull()) {
     LOG(ERROR) << "Failed to retrieve Brave Rewards resource, url: " << url;
-    std::move(got_data_callback).Run(nullptr);
+    RunPendingCallbacks(url, nullptr);
     return;
   }
 
-  std::move(got_data_callback).Run(BitmapToMemory(&bitmap).get());
+  scoped_refptr<base::RefCountedMemory> data = BitmapToMemory(&bitmap);
+  memory_cache_.Put(url, {data, base::Time::Now()});
+  RunPendingCallbacks(url, data);
+}
+
+void BraveRewardsSource::RunPendingCallbacks(
+    const GURL& url,
+    scoped_refptr<base::RefCountedMemory> data) {
+  auto it = pending_requests_.find(url);
+  if (it == pending_requests_.end())
+    return;
 
-  auto it_url =
-      find(resource_fetchers_.begin(), resource_fetchers_.end(), url);
-  if (it_url != resource_fetchers_.end()) {
-    resource_fetchers_.erase(it_url);
-  }
+  auto callbacks = std::move(it->second);
+  pending_requests_.erase(it);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(data);
 }
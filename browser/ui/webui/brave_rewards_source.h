@@ -6,17 +6,26 @@
 #ifndef BRAVE_BROWSER_UI_WEBUI_BRAVE_REWARDS_SOURCE_H_
 #define BRAVE_BROWSER_UI_WEBUI_BRAVE_REWARDS_SOURCE_H_
 
+#include <map>
 #include <string>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service.h"
 #include "content/public/browser/url_data_source.h"
+#include "url/gurl.h"
 
-class GURL;
 class Profile;
 class SkBitmap;
 
+// Serves publisher favicons and other rewards images to the rewards WebUI.
+// Encoded images are kept in an in-memory LRU cache only, so nothing outlives
+// the browser session, and concurrent requests for the same image share a
+// single fetch.
 class BraveRewardsSource : public content::URLDataSource {
  public:
   explicit BraveRewardsSource(Profile* profile);
@@ -39,14 +48,26 @@ class BraveRewardsSource : public content::URLDataSource {
                             content::BrowserContext* browser_context,
                             int render_process_id) override;
 
- private:
-  void OnBitmapFetched(
-      content::URLDataSource::GotDataCallback got_data_callback,
+ protected:
+  // Fetches |url| from the network. Overridden in tests.
+  virtual void FetchBitmap(
       const GURL& url,
-      const SkBitmap& bitmap);
+      BitmapFetcherService::BitmapFetchedCallback callback);
+
+ private:
+  struct CacheEntry {
+    scoped_refptr<base::RefCountedMemory> data;
+    base::Time fetched_at;
+  };
+
+  void OnBitmapFetched(const GURL& url, const SkBitmap& bitmap);
+  void RunPendingCallbacks(const GURL& url,
+                           scoped_refptr<base::RefCountedMemory> data);
 
   Profile* profile_;
-  std::vector<GURL> resource_fetchers_;
+  base::MRUCache<GURL, CacheEntry> memory_cache_;
+  std::map<GURL, std::vector<content::URLDataSource::GotDataCallback>>
+      pending_requests_;
 
   base::WeakPtrFactory<BraveRewardsSource> weak_factory_{this};
 };
@@ -0,0 +1,143 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/ui/webui/brave_rewards_source.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/time/time.h"
+#include "chrome/test/base/testing_profile.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColor.h"
+
+// npm run test -- brave_unit_tests --filter=BraveRewardsSourceTest.*
+
+namespace {
+
+constexpr char kImageURL[] =
+    "chrome://rewards-image/https://example.com/favicon.png";
+
+class TestRewardsSource : public BraveRewardsSource {
+ public:
+  using BraveRewardsSource::BraveRewardsSource;
+
+  void CompleteFetches(const SkBitmap& bitmap) {
+    auto callbacks = std::move(pending_fetches_);
+    for (auto& callback : callbacks)
+      std::move(callback).Run(bitmap);
+  }
+
+  int fetch_count() const { return fetch_count_; }
+
+ protected:
+  void FetchBitmap(
+      const GURL& url,
+      BitmapFetcherService::BitmapFetchedCallback callback) override {
+    fetch_count_++;
+    pending_fetches_.push_back(std::move(callback));
+  }
+
+ private:
+  int fetch_count_ = 0;
+  std::vector<BitmapFetcherService::BitmapFetchedCallback> pending_fetches_;
+};
+
+SkBitmap CreateBitmap() {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(16, 16);
+  bitmap.eraseColor(SK_ColorRED);
+  return bitmap;
+}
+
+}  // namespace
+
+class BraveRewardsSourceTest : public testing::Test {
+ public:
+  BraveRewardsSourceTest() = default;
+
+  void SetUp() override {
+    profile_ = std::make_unique<TestingProfile>();
+    source_ = std::make_unique<TestRewardsSource>(profile_.get());
+  }
+
+  // Requests the test image from |source| and records how many requests
+  // were answered, and with how many non-empty results.
+  void RequestImage(TestRewardsSource* source) {
+    source->StartDataRequest(
+        GURL(kImageURL), content::WebContents::Getter(),
+        base::BindOnce(
+            [](BraveRewardsSourceTest* test,
+               scoped_refptr<base::RefCountedMemory> data) {
+              test->responses_++;
+              if (data && data->size() > 0)
+                test->successful_responses_++;
+            },
+            base::Unretained(this)));
+  }
+
+ protected:
+  content::BrowserTaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  std::unique_ptr<TestingProfile> profile_;
+  std::unique_ptr<TestRewardsSource> source_;
+  int responses_ = 0;
+  int successful_responses_ = 0;
+};
+
+TEST_F(BraveRewardsSourceTest, CoalescesConcurrentRequests) {
+  RequestImage(source_.get());
+  RequestImage(source_.get());
+  RequestImage(source_.get());
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(1, source_->fetch_count());
+  EXPECT_EQ(0, responses_);
+
+  source_->CompleteFetches(CreateBitmap());
+  EXPECT_EQ(3, responses_);
+  EXPECT_EQ(3, successful_responses_);
+}
+
+TEST_F(BraveRewardsSourceTest, ServesFromMemoryCache) {
+  RequestImage(source_.get());
+  task_environment_.RunUntilIdle();
+  source_->CompleteFetches(CreateBitmap());
+
+  for (int i = 0; i < 10; ++i)
+    RequestImage(source_.get());
+  EXPECT_EQ(1, source_->fetch_count());
+  EXPECT_EQ(11, successful_responses_);
+}
+
+TEST_F(BraveRewardsSourceTest, RefetchesExpiredEntries) {
+  RequestImage(source_.get());
+  task_environment_.RunUntilIdle();
+  source_->CompleteFetches(CreateBitmap());
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromHours(23));
+  RequestImage(source_.get());
+  EXPECT_EQ(1, source_->fetch_count());
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromHours(2));
+  RequestImage(source_.get());
+  EXPECT_EQ(2, source_->fetch_count());
+}
+
+TEST_F(BraveRewardsSourceTest, DoesNotCacheFailedFetches) {
+  RequestImage(source_.get());
+  RequestImage(source_.get());
+  task_environment_.RunUntilIdle();
+  source_->CompleteFetches(SkBitmap());
+  EXPECT_EQ(2, responses_);
+  EXPECT_EQ(0, successful_responses_);
+
+  RequestImage(source_.get());
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(2, source_->fetch_count());
+}
@@ -40,6 +40,8 @@
 #include "components/prefs/pref_change_registrar.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_ui.h"
 #include "content/public/browser/web_ui_data_source.h"
 
 using ntp_background_images::features::kBraveNTPBrandedWallpaper;
@@ -62,6 +64,10 @@ using ntp_background_images::ViewCounterServiceFactory;
 
 namespace {
 
+// Stats and preferences changes are sent to the page at most once per frame.
+constexpr base::TimeDelta kUpdateInterval =
+    base::TimeDelta::FromMilliseconds(16);
+
 bool IsPrivateNewTab(Profile* profile) {
   return profile->IsIncognitoProfile() || profile->IsGuestSession();
 }
@@ -135,6 +141,20 @@ base::DictionaryValue GetTorPropertiesDictionary(bool connected,
   return tor_data;
 }
 
+// Returns the entries of |current| which are missing from or differ in
+// |last_sent|.
+base::Value GetChangedValues(const base::Value& current,
+                             const base::Value& last_sent) {
+  base::Value changed(base::Value::Type::DICTIONARY);
+  for (const auto item : current.DictItems()) {
+    const base::Value* previous =
+        last_sent.is_dict() ? last_sent.FindKey(item.first) : nullptr;
+    if (!previous || *previous != item.second)
+      changed.SetKey(item.first, item.second.Clone());
+  }
+  return changed;
+}
+
 // TODO(petemill): Move p3a to own NTP component so it can
 // be used by other platforms.
 
@@ -423,10 +443,20 @@ void BraveNewTabMessageHandler::OnJavascriptAllowed() {
   if (tor_launcher_factory_)
     tor_launcher_factory_->AddObserver(this);
 #endif
+
+  // Stats and preferences are only pushed while the page is visible.
+  Observe(web_ui()->GetWebContents());
 }
 
 void BraveNewTabMessageHandler::OnJavascriptDisallowed() {
   pref_change_registrar_.RemoveAll();
+  Observe(nullptr);
+  update_timer_.Stop();
+  stats_dirty_ = false;
+  preferences_dirty_ = false;
+  // Page will request full data again once javascript is allowed.
+  last_sent_stats_ = base::Value();
+  last_sent_preferences_ = base::Value();
 #if BUILDFLAG(ENABLE_TOR)
   if (tor_launcher_factory_)
     tor_launcher_factory_->RemoveObserver(this);
@@ -439,6 +469,8 @@ void BraveNewTabMessageHandler::HandleGetPreferences(
   PrefService* prefs = profile_->GetPrefs();
   auto data = GetPreferencesDictionary(prefs);
   ResolveJavascriptCallback(args->GetList()[0], data);
+  last_sent_preferences_ = std::move(data);
+  preferences_dirty_ = false;
 }
 
 void BraveNewTabMessageHandler::HandleGetStats(const base::ListValue* args) {
@@ -446,6 +478,8 @@ void BraveNewTabMessageHandler::HandleGetStats(const base::ListValue* args) {
   PrefService* prefs = profile_->GetPrefs();
   auto data = GetStatsDictionary(prefs);
   ResolveJavascriptCallback(args->GetList()[0], data);
+  last_sent_stats_ = std::move(data);
+  stats_dirty_ = false;
 }
 
 void BraveNewTabMessageHandler::HandleGetPrivateProperties(
@@ -816,15 +850,64 @@ void BraveNewTabMessageHandler::OnPrivatePropertiesChanged() {
 }
 
 void BraveNewTabMessageHandler::OnStatsChanged() {
-  PrefService* prefs = profile_->GetPrefs();
-  auto data = GetStatsDictionary(prefs);
-  FireWebUIListener("stats-updated", data);
+  stats_dirty_ = true;
+  ScheduleUpdates();
 }
 
 void BraveNewTabMessageHandler::OnPreferencesChanged() {
+  preferences_dirty_ = true;
+  ScheduleUpdates();
+}
+
+void BraveNewTabMessageHandler::ScheduleUpdates() {
+  // Hidden pages are resynced from OnVisibilityChanged().
+  if (!IsPageVisible() || update_timer_.IsRunning())
+    return;
+  update_timer_.Start(
+      FROM_HERE, kUpdateInterval,
+      base::BindOnce(&BraveNewTabMessageHandler::FlushPendingUpdates,
+                     base::Unretained(this)));
+}
+
+void BraveNewTabMessageHandler::FlushPendingUpdates() {
+  if (!IsJavascriptAllowed() || !IsPageVisible())
+    return;
+
   PrefService* prefs = profile_->GetPrefs();
-  auto data = GetPreferencesDictionary(prefs);
-  FireWebUIListener("preferences-changed", data);
+  if (stats_dirty_) {
+    stats_dirty_ = false;
+    base::Value data = GetStatsDictionary(prefs);
+    base::Value changed = GetChangedValues(data, last_sent_stats_);
+    if (!changed.DictEmpty()) {
+      FireWebUIListener("stats-updated", changed);
+      last_sent_stats_ = std::move(data);
+    }
+  }
+  if (preferences_dirty_) {
+    preferences_dirty_ = false;
+    base::Value data = GetPreferencesDictionary(prefs);
+    base::Value changed = GetChangedValues(data, last_sent_preferences_);
+    if (!changed.DictEmpty()) {
+      FireWebUIListener("preferences-changed", changed);
+      last_sent_preferences_ = std::move(data);
+    }
+  }
+}
+
+bool BraveNewTabMessageHandler::IsPageVisible() const {
+  // Without a WebContents (e.g. in tests) treat the page as visible.
+  return !web_contents() ||
+         web_contents()->GetVisibility() != content::Visibility::HIDDEN;
+}
+
+void BraveNewTabMessageHandler::OnVisibilityChanged(
+    content::Visibility visibility) {
+  if (visibility == content::Visibility::HIDDEN) {
+    update_timer_.Stop();
+    return;
+  }
+  if (stats_dirty_ || preferences_dirty_)
+    ScheduleUpdates();
 }
 
 void BraveNewTabMessageHandler::OnTorCircuitEstablished(bool result) {
@@ -9,9 +9,12 @@
 #include <string>
 
 #include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
+#include "base/values.h"
 #include "brave/components/tor/buildflags/buildflags.h"
 #include "brave/components/tor/tor_launcher_observer.h"
 #include "components/prefs/pref_change_registrar.h"
+#include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_ui_message_handler.h"
 
 class Profile;
@@ -31,8 +34,12 @@ class TorLauncherFactory;
 class PrefRegistrySimple;
 class PrefService;
 
-// Handles messages to and from the New Tab Page javascript
+// Handles messages to and from the New Tab Page javascript.
+// Stats and preferences updates are coalesced, only the fields which changed
+// since the last message are sent, and nothing is sent while the page is
+// hidden. Pending changes are flushed once the page becomes visible again.
 class BraveNewTabMessageHandler : public content::WebUIMessageHandler,
+                                  public content::WebContentsObserver,
                                   public TorLauncherObserver {
  public:
   explicit BraveNewTabMessageHandler(Profile* profile);
@@ -77,11 +84,24 @@ class BraveNewTabMessageHandler : public content::WebUIMessageHandler,
   void OnPreferencesChanged();
   void OnPrivatePropertiesChanged();
 
+  void ScheduleUpdates();
+  void FlushPendingUpdates();
+  bool IsPageVisible() const;
+
+  // content::WebContentsObserver:
+  void OnVisibilityChanged(content::Visibility visibility) override;
+
   // TorLauncherObserver:
   void OnTorCircuitEstablished(bool result) override;
   void OnTorInitializing(const std::string& percentage) override;
 
   PrefChangeRegistrar pref_change_registrar_;
+  // Last values known to the page, used to only send changed fields.
+  base::Value last_sent_stats_;
+  base::Value last_sent_preferences_;
+  bool stats_dirty_ = false;
+  bool preferences_dirty_ = false;
+  base::OneShotTimer update_timer_;
   // Weak pointer.
   Profile* profile_;
 #if BUILDFLAG(ENABLE_TOR)
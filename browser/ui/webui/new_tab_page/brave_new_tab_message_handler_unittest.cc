@@ -5,9 +5,21 @@
 
 #include "brave/browser/ui/webui/new_tab_page/brave_new_tab_message_handler.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "base/test/simple_test_clock.h"
 #include "base/time/time.h"
+#include "base/values.h"
+#include "brave/common/pref_names.h"
 #include "chrome/browser/first_run/first_run.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/test/base/chrome_render_view_host_test_harness.h"
+#include "components/prefs/pref_service.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/test_web_ui.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 TEST(BraveNewTabMessageHandlerTest, TalkPrompt) {
@@ -19,3 +31,113 @@ TEST(BraveNewTabMessageHandlerTest, TalkPrompt) {
   clock->Advance(base::TimeDelta::FromDays(1));
   EXPECT_EQ(BraveNewTabMessageHandler::CanPromptBraveTalk(clock->Now()), true);
 }
+
+class BraveNewTabMessageHandlerUpdatesTest
+    : public ChromeRenderViewHostTestHarness {
+ public:
+  BraveNewTabMessageHandlerUpdatesTest()
+      : ChromeRenderViewHostTestHarness(
+            content::BrowserTaskEnvironment::TimeSource::MOCK_TIME) {}
+
+  void SetUp() override {
+    ChromeRenderViewHostTestHarness::SetUp();
+    web_ui_ = std::make_unique<content::TestWebUI>();
+    web_ui_->set_web_contents(web_contents());
+    auto handler = std::make_unique<BraveNewTabMessageHandler>(profile());
+    handler_ = handler.get();
+    web_ui_->AddMessageHandler(std::move(handler));
+    handler_->AllowJavascriptForTesting();
+  }
+
+  void TearDown() override {
+    handler_ = nullptr;
+    web_ui_.reset();
+    ChromeRenderViewHostTestHarness::TearDown();
+  }
+
+  // Simulates the page requesting the full data set and drops the reply.
+  void RequestInitialData(const std::string& message) {
+    base::ListValue args;
+    args.Append("callback-id");
+    web_ui_->HandleReceivedMessage(message, &args);
+    web_ui_->ClearTrackedCalls();
+  }
+
+  // Returns the data of every listener message fired for |event|.
+  std::vector<const base::Value*> GetListenerCalls(const std::string& event) {
+    std::vector<const base::Value*> calls;
+    for (const auto& call : web_ui_->call_data()) {
+      if (call->function_name() == "cr.webUIListenerCallback" &&
+          call->arg1()->GetString() == event) {
+        calls.push_back(call->arg2());
+      }
+    }
+    return calls;
+  }
+
+  void FastForwardPastUpdateInterval() {
+    task_environment()->FastForwardBy(base::TimeDelta::FromMilliseconds(50));
+  }
+
+  PrefService* prefs() { return profile()->GetPrefs(); }
+
+ protected:
+  std::unique_ptr<content::TestWebUI> web_ui_;
+  BraveNewTabMessageHandler* handler_ = nullptr;
+};
+
+TEST_F(BraveNewTabMessageHandlerUpdatesTest, CoalescesStatsUpdates) {
+  RequestInitialData("getNewTabPageStats");
+
+  prefs()->SetUint64(kAdsBlocked, 1);
+  prefs()->SetUint64(kAdsBlocked, 2);
+  prefs()->SetUint64(kJavascriptBlocked, 3);
+  EXPECT_TRUE(GetListenerCalls("stats-updated").empty());
+
+  FastForwardPastUpdateInterval();
+  auto calls = GetListenerCalls("stats-updated");
+  ASSERT_EQ(1u, calls.size());
+  EXPECT_EQ(2u, calls[0]->DictSize());
+  EXPECT_EQ(2, calls[0]->FindIntKey("adsBlockedStat"));
+  EXPECT_EQ(3, calls[0]->FindIntKey("javascriptBlockedStat"));
+  EXPECT_FALSE(calls[0]->FindKey("fingerprintingBlockedStat"));
+}
+
+TEST_F(BraveNewTabMessageHandlerUpdatesTest, SendsOnlyChangedPreferences) {
+  RequestInitialData("getNewTabPagePreferences");
+
+  prefs()->SetBoolean(kNewTabPageShowClock,
+                      !prefs()->GetBoolean(kNewTabPageShowClock));
+  FastForwardPastUpdateInterval();
+
+  auto calls = GetListenerCalls("preferences-changed");
+  ASSERT_EQ(1u, calls.size());
+  EXPECT_EQ(1u, calls[0]->DictSize());
+  EXPECT_TRUE(calls[0]->FindKey("showClock"));
+}
+
+TEST_F(BraveNewTabMessageHandlerUpdatesTest, SkipsUnchangedFields) {
+  RequestInitialData("getNewTabPageStats");
+
+  // HTTPS upgrades are observed but not displayed, so nothing is sent.
+  prefs()->SetUint64(kHttpsUpgrades, 10);
+  FastForwardPastUpdateInterval();
+  EXPECT_TRUE(GetListenerCalls("stats-updated").empty());
+}
+
+TEST_F(BraveNewTabMessageHandlerUpdatesTest, SuspendsUpdatesWhileHidden) {
+  RequestInitialData("getNewTabPageStats");
+
+  web_contents()->WasHidden();
+  for (uint64_t i = 1; i <= 100; ++i) {
+    prefs()->SetUint64(kAdsBlocked, i);
+    FastForwardPastUpdateInterval();
+  }
+  EXPECT_TRUE(GetListenerCalls("stats-updated").empty());
+
+  web_contents()->WasShown();
+  FastForwardPastUpdateInterval();
+  auto calls = GetListenerCalls("stats-updated");
+  ASSERT_EQ(1u, calls.size());
+  EXPECT_EQ(100, calls[0]->FindIntKey("adsBlockedStat"));
+}
@@ -12,7 +12,7 @@
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "brave/common/importer/importer_constants.h"
-#include "brave/common/importer/scoped_copy_file.h"
+#include "brave/common/importer/source_profile_database.h"
 #include "chrome/common/importer/importer_data_types.h"
 #include "components/webdata/common/webdata_constants.h"
 #include "sql/database.h"
@@ -50,20 +50,12 @@ bool HasImportableExtensions(const base::FilePath& secured_preference_path) {
 #endif
 
 bool HasPaymentMethods(const base::FilePath& payments_path) {
-  if (!base::PathExists(payments_path))
+  SourceProfileDatabase payments_db;
+  if (!payments_db.Open(payments_path))
     return false;
 
-  ScopedCopyFile copy_payments_file(payments_path);
-  if (!copy_payments_file.copy_success())
-    return false;
-
-  sql::Database db;
-  if (!db.Open(copy_payments_file.copied_file_path())) {
-    return false;
-  }
-
   constexpr char query[] = "SELECT name_on_card FROM credit_cards;";
-  sql::Statement s(db.GetUniqueStatement(query));
+  sql::Statement s(payments_db.db()->GetUniqueStatement(query));
   // Will return false if there is no payment info.
   return s.Step();
 }
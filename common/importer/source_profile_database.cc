@@ -0,0 +1,121 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/common/importer/source_profile_database.h"
+
+#include "base/files/file_util.h"
+#include "brave/common/importer/scoped_copy_file.h"
+#include "third_party/sqlite/sqlite3.h"
+
+namespace {
+
+// Offset of the file format write and read version bytes in the database
+// header, which are both 2 for a database in write-ahead log mode.
+constexpr int kFileFormatVersionOffset = 18;
+
+enum class SnapshotResult { kSuccess, kLocked, kFailed };
+
+// Even a read-only connection writes next to the source when it has to roll
+// back a hot journal or replay a write-ahead log, or when it opens the shared
+// memory file of a database in write-ahead log mode.
+bool NeedsWriteToRead(const base::FilePath& path) {
+  int64_t size = 0;
+  if (base::GetFileSize(
+          base::FilePath(path.value() + FILE_PATH_LITERAL("-journal")),
+          &size) &&
+      size > 0) {
+    return true;
+  }
+
+  if (base::PathExists(
+          base::FilePath(path.value() + FILE_PATH_LITERAL("-wal")))) {
+    return true;
+  }
+
+  char header[kFileFormatVersionOffset + 2];
+  if (base::ReadFile(path, header, sizeof(header)) !=
+      static_cast<int>(sizeof(header))) {
+    return false;
+  }
+  return header[kFileFormatVersionOffset] == 2 ||
+         header[kFileFormatVersionOffset + 1] == 2;
+}
+
+// Copies every page of |path| into |snapshot_path| in a single backup step,
+// so the source is only read under one shared lock.
+SnapshotResult Snapshot(const base::FilePath& path,
+                        const base::FilePath& snapshot_path) {
+  sqlite3* source = nullptr;
+  sqlite3* snapshot = nullptr;
+
+  int result = sqlite3_open_v2(path.AsUTF8Unsafe().c_str(), &source,
+                               SQLITE_OPEN_READONLY, nullptr);
+  if (result == SQLITE_OK) {
+    result = sqlite3_open_v2(snapshot_path.AsUTF8Unsafe().c_str(), &snapshot,
+                             SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE,
+                             nullptr);
+  }
+
+  if (result == SQLITE_OK) {
+    sqlite3_backup* backup =
+        sqlite3_backup_init(snapshot, "main", source, "main");
+    if (backup) {
+      result = sqlite3_backup_step(backup, -1);
+      sqlite3_backup_finish(backup);
+    } else {
+      result = sqlite3_errcode(snapshot);
+    }
+  }
+
+  sqlite3_close(snapshot);
+  sqlite3_close(source);
+
+  switch (result) {
+    case SQLITE_DONE:
+      return SnapshotResult::kSuccess;
+    case SQLITE_BUSY:
+    case SQLITE_LOCKED:
+      return SnapshotResult::kLocked;
+    default:
+      return SnapshotResult::kFailed;
+  }
+}
+
+}  // namespace
+
+SourceProfileDatabase::SourceProfileDatabase() = default;
+
+SourceProfileDatabase::~SourceProfileDatabase() {
+  // Close before the snapshot or copy is deleted underneath.
+  db_.Close();
+}
+
+bool SourceProfileDatabase::Open(const base::FilePath& path) {
+  if (!base::PathExists(path))
+    return false;
+
+  if (!NeedsWriteToRead(path)) {
+    if (!snapshot_dir_.CreateUniqueTempDir())
+      return false;
+
+    const base::FilePath snapshot_path =
+        snapshot_dir_.GetPath().AppendASCII("snapshot");
+    switch (Snapshot(path, snapshot_path)) {
+      case SnapshotResult::kSuccess:
+        return db_.Open(snapshot_path);
+      case SnapshotResult::kFailed:
+        return false;
+      case SnapshotResult::kLocked:
+        // The other browser is writing to it, so fall back to a copy.
+        break;
+    }
+  }
+
+  copy_ = std::make_unique<ScopedCopyFile>(path);
+  if (!copy_->copy_success())
+    return false;
+
+  return db_.Open(copy_->copied_file_path());
+}
@@ -0,0 +1,44 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMMON_IMPORTER_SOURCE_PROFILE_DATABASE_H_
+#define BRAVE_COMMON_IMPORTER_SOURCE_PROFILE_DATABASE_H_
+
+#include <memory>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "sql/database.h"
+
+class ScopedCopyFile;
+
+// Opens a SQLite database that belongs to another browser's profile without
+// writing to it. The source is opened read-only and snapshotted with the
+// SQLite backup API, which reads it under a shared lock, so the snapshot is
+// consistent and nothing is written next to or into the source. Only when the
+// other browser holds the database locked, or it would need a journal rolled
+// back or a write-ahead log replayed to be read, is the file copied instead.
+class SourceProfileDatabase {
+ public:
+  SourceProfileDatabase();
+  ~SourceProfileDatabase();
+
+  SourceProfileDatabase(const SourceProfileDatabase&) = delete;
+  SourceProfileDatabase& operator=(const SourceProfileDatabase&) = delete;
+
+  bool Open(const base::FilePath& path);
+
+  sql::Database* db() { return &db_; }
+
+  // Whether the source had to be copied because it could not be snapshotted.
+  bool copied() const { return !!copy_; }
+
+ private:
+  sql::Database db_;
+  base::ScopedTempDir snapshot_dir_;
+  std::unique_ptr<ScopedCopyFile> copy_;
+};
+
+#endif  // BRAVE_COMMON_IMPORTER_SOURCE_PROFILE_DATABASE_H_
@@ -0,0 +1,114 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/common/importer/source_profile_database.h"
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/path_service.h"
+#include "brave/common/brave_paths.h"
+#include "sql/database.h"
+#include "sql/statement.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+int CountUrls(sql::Database* db) {
+  sql::Statement s(db->GetUniqueStatement("SELECT COUNT(*) FROM urls"));
+  return s.Step() ? s.ColumnInt(0) : -1;
+}
+
+}  // namespace
+
+class SourceProfileDatabaseTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    base::FilePath test_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_dir);
+    history_path_ = temp_dir_.GetPath().AppendASCII("History");
+    ASSERT_TRUE(base::CopyFile(test_dir.AppendASCII("import")
+                                   .AppendASCII("chrome")
+                                   .AppendASCII("default")
+                                   .AppendASCII("History"),
+                               history_path_));
+    ASSERT_TRUE(base::GetFileSize(history_path_, &history_size_));
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath history_path_;
+  int64_t history_size_ = 0;
+};
+
+TEST_F(SourceProfileDatabaseTest, SnapshotsUnlockedDatabaseWithoutWriting) {
+  base::File::Info before;
+  ASSERT_TRUE(base::GetFileInfo(history_path_, &before));
+
+  SourceProfileDatabase db;
+  ASSERT_TRUE(db.Open(history_path_));
+  EXPECT_FALSE(db.copied());
+  EXPECT_EQ(4, CountUrls(db.db()));
+
+  // No bytes are written into or next to the source.
+  base::File::Info after;
+  ASSERT_TRUE(base::GetFileInfo(history_path_, &after));
+  EXPECT_EQ(history_size_, after.size);
+  EXPECT_EQ(before.last_modified, after.last_modified);
+  for (const auto* suffix : {FILE_PATH_LITERAL("-journal"),
+                             FILE_PATH_LITERAL("-wal"),
+                             FILE_PATH_LITERAL("-shm")}) {
+    EXPECT_FALSE(
+        base::PathExists(base::FilePath(history_path_.value() + suffix)));
+  }
+}
+
+TEST_F(SourceProfileDatabaseTest, CopiesLockedDatabase) {
+  // Simulates the source browser running and holding its database.
+  sql::Database owner;
+  ASSERT_TRUE(owner.Open(history_path_));
+  ASSERT_TRUE(owner.Execute("BEGIN EXCLUSIVE"));
+
+  SourceProfileDatabase db;
+  ASSERT_TRUE(db.Open(history_path_));
+  EXPECT_TRUE(db.copied());
+  EXPECT_EQ(4, CountUrls(db.db()));
+
+  ASSERT_TRUE(owner.Execute("COMMIT"));
+}
+
+TEST_F(SourceProfileDatabaseTest, CopiesDatabaseWithPendingJournal) {
+  ASSERT_TRUE(base::WriteFile(
+      base::FilePath(history_path_.value() + FILE_PATH_LITERAL("-journal")),
+      "journal"));
+
+  SourceProfileDatabase db;
+  ASSERT_TRUE(db.Open(history_path_));
+  EXPECT_TRUE(db.copied());
+  EXPECT_EQ(4, CountUrls(db.db()));
+}
+
+TEST_F(SourceProfileDatabaseTest, DoesNotBlockSourceWritesWhileReading) {
+  SourceProfileDatabase db;
+  ASSERT_TRUE(db.Open(history_path_));
+  sql::Statement urls(db.db()->GetUniqueStatement("SELECT id FROM urls"));
+  ASSERT_TRUE(urls.Step());
+
+  // The source browser keeps writing while the import is part way through.
+  sql::Database owner;
+  ASSERT_TRUE(owner.Open(history_path_));
+  EXPECT_TRUE(owner.Execute("DELETE FROM urls"));
+
+  int count = 1;
+  while (urls.Step())
+    count++;
+  EXPECT_EQ(4, count);
+}
+
+TEST_F(SourceProfileDatabaseTest, FailsForMissingFile) {
+  SourceProfileDatabase db;
+  EXPECT_FALSE(db.Open(temp_dir_.GetPath().AppendASCII("Missing")));
+}
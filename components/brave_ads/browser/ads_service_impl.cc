@@ -222,6 +222,8 @@ AdsServiceImpl::AdsServiceImpl(Profile* profile,
   DCHECK(history_service_);
   DCHECK(brave::IsRegularProfile(profile_));
 
+  history_service_observation_.Observe(history_service_);
+
   MigratePrefs();
 
   MaybeInitialize();
@@ -574,6 +576,8 @@ void AdsServiceImpl::Shutdown() {
 
   g_brave_browser_process->resource_component()->RemoveObserver(this);
 
+  history_service_observation_.Reset();
+
   url_loaders_.clear();
 
   idle_poll_timer_.Stop();
@@ -2290,4 +2294,32 @@ void AdsServiceImpl::OnForeground() {
   bat_ads_->OnForeground();
 }
 
+void AdsServiceImpl::OnURLVisited(history::HistoryService* history_service,
+                                  ui::PageTransition transition,
+                                  const history::URLRow& row,
+                                  const history::RedirectList& redirects,
+                                  base::Time visit_time) {
+  if (!connected()) {
+    return;
+  }
+
+  // Sites are sent in the same form as |GetBrowsingHistory| results
+  bat_ads_->OnBrowsingHistoryVisited(row.url().GetWithEmptyPath().spec());
+}
+
+void AdsServiceImpl::OnURLsDeleted(history::HistoryService* history_service,
+                                   const history::DeletionInfo& deletion_info) {
+  if (!connected()) {
+    return;
+  }
+
+  // Expired visits are dropped when ads next query history, which happens at
+  // least daily, so only deletions made by the user are sent
+  if (deletion_info.is_from_expiration()) {
+    return;
+  }
+
+  bat_ads_->OnBrowsingHistoryDeleted();
+}
+
 }  // namespace brave_ads
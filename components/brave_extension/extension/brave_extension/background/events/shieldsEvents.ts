@@ -3,11 +3,15 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 import actions from '../actions/shieldsPanelActions'
-import { BlockDetails } from '../../types/actions/shieldsPanelActions'
 
 if (chrome.braveShields) {
-  chrome.braveShields.onBlocked.addListener((detail: BlockDetails) => {
-    actions.resourceBlocked(detail)
+  // Blocked resources arrive batched per tab and grouped by block type.
+  chrome.braveShields.onBlocked.addListener((details: BlockedResourcesDetails) => {
+    for (const { blockType, subresources } of details.blocked) {
+      for (const subresource of subresources) {
+        actions.resourceBlocked({ tabId: details.tabId, blockType, subresource })
+      }
+    }
   })
 } else {
   console.log('chrome.braveShields not enabled')
@@ -14,8 +14,14 @@ import { addWebUIListener, sendWithPromise } from '../../common/cr'
 
 type PreferencesUpdatedHandler = (prefData: NewTab.Preferences) => void
 
-export function getPreferences (): Promise<NewTab.Preferences> {
-  return sendWithPromise<NewTab.Preferences>('getNewTabPagePreferences')
+// The backend only sends preferences which changed, so keep the latest
+// full set of preferences to merge updates into.
+let currentPreferences: NewTab.Preferences
+
+export async function getPreferences (): Promise<NewTab.Preferences> {
+  currentPreferences =
+    await sendWithPromise<NewTab.Preferences>('getNewTabPagePreferences')
+  return currentPreferences
 }
 
 function sendSavePref (key: string, value: any) {
@@ -83,5 +89,9 @@ export function saveSetAllStackWidgets (visible: boolean): void {
 }
 
 export function addChangeListener (listener: PreferencesUpdatedHandler): void {
-  addWebUIListener('preferences-changed', listener)
+  addWebUIListener('preferences-changed',
+    (changedPreferences: Partial<NewTab.Preferences>) => {
+      currentPreferences = { ...currentPreferences, ...changedPreferences }
+      listener(currentPreferences)
+    })
 }
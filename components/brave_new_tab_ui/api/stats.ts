@@ -22,10 +22,18 @@ export type Stats = {
 
 type StatsUpdatedHandler = (statsData: Stats) => void
 
-export function getStats (): Promise<Stats> {
-  return Cr.sendWithPromise<Stats>('getNewTabPageStats')
+// The backend only sends fields which changed, so keep the latest
+// full set of stats to merge updates into.
+let currentStats: Stats
+
+export async function getStats (): Promise<Stats> {
+  currentStats = await Cr.sendWithPromise<Stats>('getNewTabPageStats')
+  return currentStats
 }
 
 export function addChangeListener (listener: StatsUpdatedHandler): void {
-  Cr.addWebUIListener('stats-updated', listener)
+  Cr.addWebUIListener('stats-updated', (changedStats: Partial<Stats>) => {
+    currentStats = { ...currentStats, ...changedStats }
+    listener(currentStats)
+  })
 }
@@ -72,7 +72,6 @@
 #include "content/public/browser/service_process_host.h"
 #include "content/public/browser/storage_partition.h"
 #include "content/public/browser/url_data_source.h"
-#include "net/base/escape.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "net/base/url_util.h"
 #include "net/http/http_status_code.h"
@@ -803,10 +802,6 @@ void RewardsServiceImpl::RestorePublishers() {
                    AsWeakPtr()));
 }
 
-std::string RewardsServiceImpl::URIEncode(const std::string& value) {
-  return net::EscapeQueryParamValue(value, false);
-}
-
 void RewardsServiceImpl::Shutdown() {
   RemoveObserver(notification_service_.get());
 
@@ -155,7 +155,6 @@ class RewardsServiceImpl : public RewardsService,
                   const GURL& first_party_url,
                   const GURL& referrer,
                   const std::string& post_data) override;
-  std::string URIEncode(const std::string& value) override;
   void GetReconcileStamp(GetReconcileStampCallback callback) override;
   void GetAutoContributeEnabled(
       GetAutoContributeEnabledCallback callback) override;
@@ -57,6 +57,11 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
+  // Returns a counter that is incremented whenever the rules of any ad-block
+  // engine change, so results computed against an older value may be stale.
+  // Safe to call from any thread.
+  static uint64_t GetEngineGeneration();
+
   virtual absl::optional<base::Value> UrlCosmeticResources(
       const std::string& url);
   virtual absl::optional<base::Value> HiddenClassIdSelectors(
@@ -74,6 +79,7 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void AddKnownTagsToAdBlockInstance();
   void AddKnownResourcesToAdBlockInstance();
   void ResetForTest(const std::string& rules, const std::string& resources);
+  static void OnEngineChanged();
 
   std::unique_ptr<adblock::Engine> ad_block_client_;
 
@@ -6,14 +6,23 @@
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 
 #include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/feature_list.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/no_destructor.h"
+#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/components/brave_shields/browser/brave_shields_p3a.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/brave_shield_utils.h"
 #include "brave/components/brave_shields/common/features.h"
 #include "brave/components/content_settings/core/common/content_settings_util.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
 #include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "components/content_settings/core/common/content_settings_types.h"
 #include "components/content_settings/core/common/pref_names.h"
@@ -54,6 +63,105 @@ ContentSetting GetDefaultBlockFromControlType(ControlType type) {
                                     : CONTENT_SETTING_BLOCK;
 }
 
+// Caches the results of the content settings lookups made by the getters
+// below. Every lookup walks each provider's rules for the content type, and
+// shields settings are read many times per page load. All entries of a content
+// type are dropped when the map reports a change to that type, since a single
+// pattern can cover any number of cached URLs.
+class ShieldsSettingsCache : public content_settings::Observer {
+ public:
+  explicit ShieldsSettingsCache(HostContentSettingsMap* map)
+      : map_(map->GetWeakPtr()), cache_(kMaxEntries) {
+    map->AddObserver(this);
+  }
+
+  ~ShieldsSettingsCache() override {
+    if (map_)
+      map_->RemoveObserver(this);
+  }
+
+  // False once the map this cache was created for has been destroyed.
+  bool is_valid() const { return !!map_; }
+
+  template <typename Callback>
+  ContentSetting Get(ContentSettingsType type,
+                     const GURL& primary_url,
+                     const GURL& secondary_url,
+                     Callback lookup) {
+    // Rules may be specific to a scheme or port, so entries are keyed by
+    // origin rather than host.
+    Key key(type, primary_url.GetOrigin().spec(),
+            secondary_url.GetOrigin().spec());
+    auto it = cache_.Get(key);
+    if (it != cache_.end())
+      return it->second;
+    ContentSetting setting = lookup();
+    cache_.Put(std::move(key), setting);
+    return setting;
+  }
+
+  // content_settings::Observer:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type) override {
+    for (auto it = cache_.begin(); it != cache_.end();) {
+      if (std::get<0>(it->first) == content_type)
+        it = cache_.Erase(it);
+      else
+        ++it;
+    }
+  }
+
+ private:
+  using Key = std::tuple<ContentSettingsType, std::string, std::string>;
+
+  static constexpr size_t kMaxEntries = 1000;
+
+  base::WeakPtr<HostContentSettingsMap> map_;
+  base::MRUCache<Key, ContentSetting> cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsCache);
+};
+
+// Returns the cache for |map|, or nullptr when lookups shouldn't be cached.
+// Content settings are only observed on the UI thread, so lookups made from
+// other threads always go to the map.
+ShieldsSettingsCache* GetShieldsSettingsCache(HostContentSettingsMap* map,
+                                              const GURL& url) {
+  if (!url.SchemeIsHTTPOrHTTPS() ||
+      !content::BrowserThread::CurrentlyOn(content::BrowserThread::UI)) {
+    return nullptr;
+  }
+
+  using CacheEntry =
+      std::pair<HostContentSettingsMap*, std::unique_ptr<ShieldsSettingsCache>>;
+  static base::NoDestructor<std::vector<CacheEntry>> caches;
+  for (auto& entry : *caches) {
+    if (entry.first == map && entry.second->is_valid())
+      return entry.second.get();
+  }
+
+  // Drop caches of destroyed maps, one of which may have had the same address.
+  base::EraseIf(*caches, [](const auto& entry) {
+    return !entry.second->is_valid();
+  });
+  caches->emplace_back(map, std::make_unique<ShieldsSettingsCache>(map));
+  return caches->back().second.get();
+}
+
+ContentSetting GetContentSettingCached(HostContentSettingsMap* map,
+                                       const GURL& primary_url,
+                                       const GURL& secondary_url,
+                                       ContentSettingsType type) {
+  auto lookup = [&]() {
+    return map->GetContentSetting(primary_url, secondary_url, type);
+  };
+  ShieldsSettingsCache* cache = GetShieldsSettingsCache(map, primary_url);
+  if (!cache)
+    return lookup();
+  return cache->Get(type, primary_url, secondary_url, lookup);
+}
+
 }  // namespace
 
 ContentSettingsPattern GetPatternFromURL(const GURL& url) {
@@ -140,7 +248,8 @@ bool GetBraveShieldsEnabled(HostContentSettingsMap* map, const GURL& url) {
     return false;
 
   ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::BRAVE_SHIELDS);
+      GetContentSettingCached(map, url, GURL(),
+                              ContentSettingsType::BRAVE_SHIELDS);
 
   // see EnableBraveShields - allow and default == true
   return setting == CONTENT_SETTING_BLOCK ? false : true;
@@ -169,8 +278,8 @@ void SetAdControlType(HostContentSettingsMap* map,
 }
 
 ControlType GetAdControlType(HostContentSettingsMap* map, const GURL& url) {
-  ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::BRAVE_ADS);
+  ContentSetting setting = GetContentSettingCached(
+      map, url, GURL(), ContentSettingsType::BRAVE_ADS);
 
   return setting == CONTENT_SETTING_ALLOW ? ControlType::ALLOW
                                           : ControlType::BLOCK;
@@ -202,12 +311,12 @@ void SetCosmeticFilteringControlType(HostContentSettingsMap* map,
 
 ControlType GetCosmeticFilteringControlType(HostContentSettingsMap* map,
                                             const GURL& url) {
-  ContentSetting setting = map->GetContentSetting(
-      url, GURL(), ContentSettingsType::BRAVE_COSMETIC_FILTERING);
+  ContentSetting setting = GetContentSettingCached(
+      map, url, GURL(), ContentSettingsType::BRAVE_COSMETIC_FILTERING);
 
   ContentSetting fp_setting =
-      map->GetContentSetting(url, GURL("https://firstParty/"),
-                             ContentSettingsType::BRAVE_COSMETIC_FILTERING);
+      GetContentSettingCached(map, url, GURL("https://firstParty/"),
+                              ContentSettingsType::BRAVE_COSMETIC_FILTERING);
 
   if (setting == CONTENT_SETTING_ALLOW) {
     return ControlType::ALLOW;
@@ -277,11 +386,12 @@ void SetCookieControlType(HostContentSettingsMap* map,
 // TODO(bridiver) - convert cookie settings to ContentSettingsType::COOKIES
 // while maintaining read backwards compat
 ControlType GetCookieControlType(HostContentSettingsMap* map, const GURL& url) {
-  ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::BRAVE_COOKIES);
+  ContentSetting setting = GetContentSettingCached(
+      map, url, GURL(), ContentSettingsType::BRAVE_COOKIES);
 
-  ContentSetting fp_setting = map->GetContentSetting(
-      url, GURL("https://firstParty/"), ContentSettingsType::BRAVE_COOKIES);
+  ContentSetting fp_setting =
+      GetContentSettingCached(map, url, GURL("https://firstParty/"),
+                              ContentSettingsType::BRAVE_COOKIES);
 
   if (setting == CONTENT_SETTING_ALLOW) {
     return ControlType::ALLOW;
@@ -293,8 +403,8 @@ ControlType GetCookieControlType(HostContentSettingsMap* map, const GURL& url) {
 }
 
 bool AllowReferrers(HostContentSettingsMap* map, const GURL& url) {
-  ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::BRAVE_REFERRERS);
+  ContentSetting setting = GetContentSettingCached(
+      map, url, GURL(), ContentSettingsType::BRAVE_REFERRERS);
 
   return setting == CONTENT_SETTING_ALLOW;
 }
@@ -334,12 +444,17 @@ void SetFingerprintingControlType(HostContentSettingsMap* map,
 
 ControlType GetFingerprintingControlType(HostContentSettingsMap* map,
                                          const GURL& url) {
-  ContentSettingsForOneType fingerprinting_rules;
-  map->GetSettingsForOneType(ContentSettingsType::BRAVE_FINGERPRINTING_V2,
-                             &fingerprinting_rules);
-
+  auto lookup = [&]() {
+    ContentSettingsForOneType fingerprinting_rules;
+    map->GetSettingsForOneType(ContentSettingsType::BRAVE_FINGERPRINTING_V2,
+                               &fingerprinting_rules);
+    return GetBraveFPContentSettingFromRules(fingerprinting_rules, url);
+  };
+  ShieldsSettingsCache* cache = GetShieldsSettingsCache(map, url);
   ContentSetting fp_setting =
-      GetBraveFPContentSettingFromRules(fingerprinting_rules, url);
+      cache ? cache->Get(ContentSettingsType::BRAVE_FINGERPRINTING_V2, url,
+                         GURL(), lookup)
+            : lookup();
   if (fp_setting == CONTENT_SETTING_DEFAULT)
     return ControlType::DEFAULT;
   return fp_setting == CONTENT_SETTING_ALLOW ? ControlType::ALLOW
@@ -380,8 +495,8 @@ void ResetHTTPSEverywhereEnabled(HostContentSettingsMap* map,
 }
 
 bool GetHTTPSEverywhereEnabled(HostContentSettingsMap* map, const GURL& url) {
-  ContentSetting setting = map->GetContentSetting(
-      url, GURL(), ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES);
+  ContentSetting setting = GetContentSettingCached(
+      map, url, GURL(), ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES);
 
   return setting == CONTENT_SETTING_ALLOW ? false : true;
 }
@@ -406,8 +521,8 @@ void SetNoScriptControlType(HostContentSettingsMap* map,
 
 ControlType GetNoScriptControlType(HostContentSettingsMap* map,
                                    const GURL& url) {
-  ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::JAVASCRIPT);
+  ContentSetting setting = GetContentSettingCached(
+      map, url, GURL(), ContentSettingsType::JAVASCRIPT);
 
   return setting == CONTENT_SETTING_ALLOW ? ControlType::ALLOW
                                           : ControlType::BLOCK;
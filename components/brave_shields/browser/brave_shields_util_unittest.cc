@@ -6,6 +6,7 @@
 #include <memory>
 
 #include "base/macros.h"
+#include "base/strings/string_number_conversions.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/features.h"
@@ -929,3 +930,43 @@ TEST_F(BraveShieldsUtilTest, ShouldDoDomainBlocking_ControlTypes) {
   setting = brave_shields::ShouldDoDomainBlocking(map, url);
   EXPECT_EQ(true, setting);
 }
+
+TEST_F(BraveShieldsUtilTest, CachedSettings_ManySiteExceptions) {
+  auto* map = HostContentSettingsMapFactory::GetForProfile(profile());
+  constexpr int kSiteCount = 2000;
+
+  for (int i = 0; i < kSiteCount; ++i) {
+    const GURL url("https://site" + base::NumberToString(i) + ".com");
+    brave_shields::SetBraveShieldsEnabled(map, i % 2, url);
+    brave_shields::SetCookieControlType(map, ControlType::ALLOW, url);
+  }
+
+  // Repeated lookups are served from the cache and stay correct.
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int i = 0; i < kSiteCount; ++i) {
+      const GURL url("https://site" + base::NumberToString(i) + ".com");
+      EXPECT_EQ(!!(i % 2), brave_shields::GetBraveShieldsEnabled(map, url));
+      EXPECT_EQ(ControlType::ALLOW,
+                brave_shields::GetCookieControlType(map, url));
+    }
+  }
+
+  // Changing a site's setting is reflected immediately.
+  const GURL url("https://site0.com");
+  brave_shields::SetBraveShieldsEnabled(map, true, url);
+  EXPECT_TRUE(brave_shields::GetBraveShieldsEnabled(map, url));
+  brave_shields::SetCookieControlType(map, ControlType::BLOCK, url);
+  EXPECT_EQ(ControlType::BLOCK, brave_shields::GetCookieControlType(map, url));
+
+  // So is a change to the default that covers every cached site.
+  map->SetContentSettingCustomScope(
+      ContentSettingsPattern::Wildcard(), ContentSettingsPattern::Wildcard(),
+      ContentSettingsType::JAVASCRIPT, CONTENT_SETTING_ALLOW);
+  EXPECT_EQ(ControlType::ALLOW,
+            brave_shields::GetNoScriptControlType(map, GURL("https://a.com")));
+  map->SetContentSettingCustomScope(
+      ContentSettingsPattern::Wildcard(), ContentSettingsPattern::Wildcard(),
+      ContentSettingsType::JAVASCRIPT, CONTENT_SETTING_BLOCK);
+  EXPECT_EQ(ControlType::BLOCK,
+            brave_shields::GetNoScriptControlType(map, GURL("https://a.com")));
+}
@@ -9,8 +9,10 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/containers/mru_cache.h"
 #include "base/feature_list.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/supports_user_data.h"
 #include "base/task/post_task.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
@@ -33,10 +35,62 @@
 
 namespace {
 
-bool ShouldBlockDomainOnTaskRunner(
+const char kAllowedURLCacheKey[] = "domain_block_allowed_url_cache";
+
+constexpr size_t kAllowedURLCacheSize = 1024;
+
+// Main frame URLs recently found not to match any domain block rule, mapped to
+// the ad-block engine generation they were checked against. Navigations to
+// these URLs proceed synchronously until the engines change. Kept per browser
+// context so that it never outlives, or is shared with, an off-the-record
+// profile. UI thread only.
+class AllowedURLCache : public base::SupportsUserData::Data {
+ public:
+  AllowedURLCache() : urls_(kAllowedURLCacheSize) {}
+  ~AllowedURLCache() override = default;
+
+  AllowedURLCache(const AllowedURLCache&) = delete;
+  AllowedURLCache& operator=(const AllowedURLCache&) = delete;
+
+  static AllowedURLCache* GetForContext(content::BrowserContext* context) {
+    auto* cache = static_cast<AllowedURLCache*>(
+        context->GetUserData(kAllowedURLCacheKey));
+    if (!cache) {
+      auto new_cache = std::make_unique<AllowedURLCache>();
+      cache = new_cache.get();
+      context->SetUserData(kAllowedURLCacheKey, std::move(new_cache));
+    }
+    return cache;
+  }
+
+  bool IsKnownAllowed(const GURL& url) {
+    auto it = urls_.Get(url.spec());
+    if (it == urls_.end())
+      return false;
+    if (it->second !=
+        brave_shields::AdBlockBaseService::GetEngineGeneration()) {
+      urls_.Erase(it);
+      return false;
+    }
+    return true;
+  }
+
+  void Put(const GURL& url, uint64_t generation) {
+    urls_.Put(url.spec(), generation);
+  }
+
+ private:
+  base::MRUCache<std::string, uint64_t> urls_;
+};
+
+std::pair<bool, uint64_t> ShouldBlockDomainOnTaskRunner(
     brave_shields::AdBlockService* ad_block_service,
     const GURL& url) {
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.DomainBlock.ShouldBlock");
+  // Read before matching, so that an engine update racing with this check
+  // makes the result look stale rather than current.
+  const uint64_t generation =
+      brave_shields::AdBlockBaseService::GetEngineGeneration();
   bool did_match_exception = false;
   bool did_match_rule = false;
   bool did_match_important = false;
@@ -49,7 +103,9 @@ bool ShouldBlockDomainOnTaskRunner(
       url, blink::mojom::ResourceType::kMainFrame, url.host(),
       aggressive_blocking, &did_match_rule, &did_match_exception,
       &did_match_important, &mock_data_url);
-  return (did_match_important || (did_match_rule && !did_match_exception));
+  return std::make_pair(
+      did_match_important || (did_match_rule && !did_match_exception),
+      generation);
 }
 
 }  // namespace
@@ -117,6 +173,15 @@ DomainBlockNavigationThrottle::WillStartRequest() {
   if (tab_storage->IsProceeding())
     return content::NavigationThrottle::PROCEED;
 
+  // Most navigations go to URLs that were already checked against the current
+  // engines, so don't queue behind subresource matching for them.
+  const bool is_known_allowed =
+      AllowedURLCache::GetForContext(web_contents->GetBrowserContext())
+          ->IsKnownAllowed(request_url);
+  UMA_HISTOGRAM_BOOLEAN("Brave.DomainBlock.Deferred", !is_known_allowed);
+  if (is_known_allowed)
+    return content::NavigationThrottle::PROCEED;
+
   // Otherwise, call the ad block service on a task runner to determine whether
   // this domain should be blocked.
   ad_block_service_->GetTaskRunner()->PostTaskAndReplyWithResult(
@@ -124,7 +189,7 @@ DomainBlockNavigationThrottle::WillStartRequest() {
       base::BindOnce(&ShouldBlockDomainOnTaskRunner, ad_block_service_,
                      request_url),
       base::BindOnce(&DomainBlockNavigationThrottle::OnShouldBlockDomain,
-                     weak_ptr_factory_.GetWeakPtr()));
+                     weak_ptr_factory_.GetWeakPtr(), request_url));
 
   // Since the call to the ad block service is asynchronous, we defer the final
   // decision of whether to allow or block this navigation. The callback from
@@ -149,10 +214,15 @@ DomainBlockNavigationThrottle::WillProcessResponse() {
 }
 
 void DomainBlockNavigationThrottle::OnShouldBlockDomain(
-    bool should_block_domain) {
+    const GURL& request_url,
+    std::pair<bool, uint64_t> result) {
+  const bool should_block_domain = result.first;
   if (should_block_domain) {
     ShowInterstitial();
   } else {
+    AllowedURLCache::GetForContext(
+        navigation_handle()->GetWebContents()->GetBrowserContext())
+        ->Put(request_url, result.second);
     // Navigation was deferred while we called the ad block service on a task
     // runner, but now we know that we want to allow navigation to continue.
     Resume();
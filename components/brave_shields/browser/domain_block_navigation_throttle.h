@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
@@ -56,7 +57,10 @@ class DomainBlockNavigationThrottle : public content::NavigationThrottle {
   const char* GetNameForLogging() override;
 
  private:
-  void OnShouldBlockDomain(bool should_block_domain);
+  // |result| holds whether the domain should be blocked and the ad-block
+  // engine generation it was checked against.
+  void OnShouldBlockDomain(const GURL& request_url,
+                           std::pair<bool, uint64_t> result);
   void ShowInterstitial();
 
   AdBlockService* ad_block_service_ = nullptr;
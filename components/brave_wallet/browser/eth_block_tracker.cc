@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_wallet/browser/eth_block_tracker.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/bind.h"
@@ -13,6 +14,15 @@
 
 namespace brave_wallet {
 
+namespace {
+
+// Polling slows down by this factor each time the block number doesn't
+// change, up to |kMaxBackoffFactor| times the interval passed to |Start()|.
+constexpr int kBackoffMultiplier = 2;
+constexpr int kMaxBackoffFactor = 8;
+
+}  // namespace
+
 EthBlockTracker::EthBlockTracker(EthJsonRpcController* rpc_controller)
     : rpc_controller_(rpc_controller), weak_factory_(this) {
   DCHECK(rpc_controller_);
@@ -20,27 +30,70 @@ EthBlockTracker::EthBlockTracker(EthJsonRpcController* rpc_controller)
 EthBlockTracker::~EthBlockTracker() = default;
 
 void EthBlockTracker::Start(base::TimeDelta interval) {
-  timer_.Start(
-      FROM_HERE, interval,
-      base::BindRepeating(
-          &EthBlockTracker::SendGetBlockNumber, weak_factory_.GetWeakPtr(),
-          base::Passed(base::BindOnce(&EthBlockTracker::OnGetBlockNumber,
-                                      weak_factory_.GetWeakPtr()))));
+  started_ = true;
+  base_interval_ = interval;
+  current_interval_ = interval;
+  ScheduleNextPoll();
 }
+
 void EthBlockTracker::Stop() {
+  started_ = false;
   timer_.Stop();
 }
 
 bool EthBlockTracker::IsRunning() const {
-  return timer_.IsRunning();
+  return started_ && !observers_.empty();
+}
+
+void EthBlockTracker::ResetPollingInterval() {
+  if (current_interval_ == base_interval_)
+    return;
+  current_interval_ = base_interval_;
+  ScheduleNextPoll();
+}
+
+void EthBlockTracker::SetIdle(bool is_idle) {
+  if (is_idle_ == is_idle)
+    return;
+  is_idle_ = is_idle;
+  ScheduleNextPoll();
 }
 
 void EthBlockTracker::AddObserver(EthBlockTracker::Observer* observer) {
+  const bool was_running = IsRunning();
   observers_.AddObserver(observer);
+  if (!was_running)
+    ScheduleNextPoll();
 }
 
 void EthBlockTracker::RemoveObserver(EthBlockTracker::Observer* observer) {
   observers_.RemoveObserver(observer);
+  if (!IsRunning())
+    timer_.Stop();
+}
+
+base::TimeDelta EthBlockTracker::GetPollingInterval() const {
+  if (is_idle_)
+    return base_interval_ * kMaxBackoffFactor;
+  return current_interval_;
+}
+
+void EthBlockTracker::ScheduleNextPoll() {
+  if (!IsRunning())
+    return;
+  timer_.Start(FROM_HERE, GetPollingInterval(),
+               base::BindOnce(&EthBlockTracker::Poll,
+                              weak_factory_.GetWeakPtr()));
+}
+
+void EthBlockTracker::Poll() {
+  SendGetBlockNumber(base::BindOnce(&EthBlockTracker::OnGetBlockNumber,
+                                    weak_factory_.GetWeakPtr()));
+}
+
+void EthBlockTracker::BackOff() {
+  current_interval_ = std::min(current_interval_ * kBackoffMultiplier,
+                               base_interval_ * kMaxBackoffFactor);
 }
 
 void EthBlockTracker::CheckForLatestBlock(
@@ -55,13 +108,23 @@ void EthBlockTracker::SendGetBlockNumber(
 
 void EthBlockTracker::OnGetBlockNumber(bool status, uint256_t block_num) {
   if (status) {
+    if (block_num != current_block_)
+      current_interval_ = base_interval_;
+    else
+      BackOff();
+
     current_block_ = block_num;
     for (auto& observer : observers_)
       observer.OnLatestBlock(block_num);
 
   } else {
     LOG(ERROR) << "GetBlockNumber failed";
+    BackOff();
   }
+
+  // Unless a poll was scheduled while this request was in flight.
+  if (!timer_.IsRunning())
+    ScheduleNextPoll();
 }
 
 }  // namespace brave_wallet
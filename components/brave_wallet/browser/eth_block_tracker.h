@@ -28,11 +28,25 @@ class EthBlockTracker {
     virtual void OnLatestBlock(uint256_t block_num) = 0;
   };
 
-  // If timer is already running, it will be replaced with new interval
+  // Polls for new blocks every |interval| while there are observers. The
+  // interval backs off while the block number is unchanged, requests fail or
+  // the tracker is idle. If timer is already running, it will be replaced with
+  // new interval.
   void Start(base::TimeDelta interval);
   void Stop();
+  // True if started and there is at least one observer to poll for.
   bool IsRunning() const;
 
+  // Returns to the |Start()| interval, e.g. after a transaction is submitted
+  // and its confirmation should be picked up quickly.
+  void ResetPollingInterval();
+  // While idle (nothing in the UI needs fresh blocks, browser backgrounded),
+  // polling uses the longest backoff interval.
+  void SetIdle(bool is_idle);
+  base::TimeDelta GetPollingIntervalForTesting() const {
+    return GetPollingInterval();
+  }
+
   void AddObserver(Observer* observer);
   void RemoveObserver(Observer* observer);
 
@@ -42,12 +56,21 @@ class EthBlockTracker {
       base::OnceCallback<void(bool status, uint256_t block_num)>);
 
  private:
+  base::TimeDelta GetPollingInterval() const;
+  void ScheduleNextPoll();
+  void Poll();
+  void BackOff();
+
   void SendGetBlockNumber(
       base::OnceCallback<void(bool status, uint256_t block_num)>);
   void OnGetBlockNumber(bool status, uint256_t block_num);
 
   uint256_t current_block_ = 0;
-  base::RepeatingTimer timer_;
+  bool started_ = false;
+  bool is_idle_ = false;
+  base::TimeDelta base_interval_;
+  base::TimeDelta current_interval_;
+  base::OneShotTimer timer_;
 
   base::ObserverList<Observer> observers_;
 
@@ -39,6 +39,18 @@ class EthBlockTrackerUnitTest : public testing::Test {
                 &url_loader_factory_)),
         rpc_controller_(mojom::Network::Mainnet, shared_url_loader_factory_) {}
 
+  // Answers every block number request with |response_block_num_| and
+  // counts the requests.
+  void RespondWithBlockNumber() {
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [&](const network::ResourceRequest& request) {
+          ++request_count_;
+          url_loader_factory_.ClearResponses();
+          url_loader_factory_.AddResponse(request.url.spec(),
+                                          GetResponseString());
+        }));
+  }
+
   std::string GetResponseString() const {
     return "{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":\"" +
            Uint256ValueToHex(response_block_num_) + "\"}";
@@ -46,6 +58,7 @@ class EthBlockTrackerUnitTest : public testing::Test {
 
  protected:
   uint256_t response_block_num_ = 0;
+  size_t request_count_ = 0;
   content::BrowserTaskEnvironment task_environment_;
   network::TestURLLoaderFactory url_loader_factory_;
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
@@ -57,6 +70,8 @@ TEST_F(EthBlockTrackerUnitTest, Timer) {
   bool request_sent = false;
   url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
       [&](const network::ResourceRequest& request) { request_sent = true; }));
+  TrackerObserver observer;
+  tracker.AddObserver(&observer);
   EXPECT_FALSE(tracker.IsRunning());
   tracker.Start(base::TimeDelta::FromSeconds(5));
   task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
@@ -153,4 +168,103 @@ TEST_F(EthBlockTrackerUnitTest, GetBlockNumberError) {
   EXPECT_TRUE(callback_called);
 }
 
+TEST_F(EthBlockTrackerUnitTest, PollsOnlyWithObservers) {
+  EthBlockTracker tracker(&rpc_controller_);
+  RespondWithBlockNumber();
+  response_block_num_ = 1;
+
+  tracker.Start(base::TimeDelta::FromSeconds(5));
+  EXPECT_FALSE(tracker.IsRunning());
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(request_count_, 0u);
+
+  TrackerObserver observer;
+  tracker.AddObserver(&observer);
+  EXPECT_TRUE(tracker.IsRunning());
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(request_count_, 1u);
+  EXPECT_EQ(observer.observer_notified_, 1u);
+
+  tracker.RemoveObserver(&observer);
+  EXPECT_FALSE(tracker.IsRunning());
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(request_count_, 1u);
+}
+
+TEST_F(EthBlockTrackerUnitTest, BacksOffWhileBlockUnchanged) {
+  EthBlockTracker tracker(&rpc_controller_);
+  RespondWithBlockNumber();
+  response_block_num_ = 1;
+  TrackerObserver observer;
+  tracker.AddObserver(&observer);
+  tracker.Start(base::TimeDelta::FromSeconds(5));
+
+  // New block, then the same block over and over: 5s, 10s, 20s, 40s, 40s.
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(request_count_, 1u);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(request_count_, 2u);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(10));
+  EXPECT_EQ(request_count_, 3u);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(20));
+  EXPECT_EQ(request_count_, 4u);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(40));
+  EXPECT_EQ(request_count_, 5u);
+  EXPECT_EQ(tracker.GetPollingIntervalForTesting(),
+            base::TimeDelta::FromSeconds(40));
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(39));
+  EXPECT_EQ(request_count_, 5u);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(request_count_, 6u);
+
+  // A new block brings polling back to the fast interval.
+  response_block_num_ = 2;
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(40));
+  EXPECT_EQ(request_count_, 7u);
+  EXPECT_EQ(tracker.GetPollingIntervalForTesting(),
+            base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(tracker.GetCurrentBlock(), uint256_t(2));
+}
+
+TEST_F(EthBlockTrackerUnitTest, ResetPollingInterval) {
+  EthBlockTracker tracker(&rpc_controller_);
+  RespondWithBlockNumber();
+  response_block_num_ = 1;
+  TrackerObserver observer;
+  tracker.AddObserver(&observer);
+  tracker.Start(base::TimeDelta::FromSeconds(5));
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(40));
+  EXPECT_EQ(request_count_, 4u);
+  EXPECT_EQ(tracker.GetPollingIntervalForTesting(),
+            base::TimeDelta::FromSeconds(40));
+
+  // e.g. a transaction was just submitted.
+  tracker.ResetPollingInterval();
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(request_count_, 5u);
+}
+
+TEST_F(EthBlockTrackerUnitTest, SetIdle) {
+  EthBlockTracker tracker(&rpc_controller_);
+  RespondWithBlockNumber();
+  TrackerObserver observer;
+  tracker.AddObserver(&observer);
+  tracker.Start(base::TimeDelta::FromSeconds(5));
+
+  tracker.SetIdle(true);
+  for (int i = 1; i <= 3; ++i) {
+    response_block_num_ = i;
+    task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(39));
+    EXPECT_EQ(request_count_, static_cast<size_t>(i - 1));
+    task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+    EXPECT_EQ(request_count_, static_cast<size_t>(i));
+  }
+
+  // Blocks kept changing, so polling is fast again once no longer idle.
+  tracker.SetIdle(false);
+  response_block_num_ = 4;
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(request_count_, 4u);
+}
+
 }  // namespace brave_wallet
@@ -22,13 +22,10 @@
 #include "third_party/blink/public/common/browser_interface_broker_proxy.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_local_frame.h"
-#include "third_party/blink/public/web/web_script_source.h"
 #include "ui/base/resource/resource_bundle.h"
 
 namespace {
 
-static base::NoDestructor<std::string> g_provider_script("");
-
 // Hardcode id to 1 as it is unused
 const uint32_t kRequestId = 1;
 const char kRequestJsonRPC[] = "2.0";
@@ -42,6 +39,33 @@ std::string LoadDataResource(const int id) {
   return std::string(resource_bundle.GetRawDataResource(id));
 }
 
+// Returns the provider script bound to |context|. The script is compiled the
+// first time a page uses window.ethereum and shared by every frame of the
+// renderer afterwards.
+v8::MaybeLocal<v8::Script> GetProviderScript(v8::Isolate* isolate,
+                                             v8::Local<v8::Context> context) {
+  static base::NoDestructor<v8::Global<v8::UnboundScript>> g_provider_script;
+  if (g_provider_script->IsEmpty()) {
+    const std::string source =
+        LoadDataResource(IDR_BRAVE_WALLET_SCRIPT_BRAVE_WALLET_SCRIPT_BUNDLE_JS);
+    v8::Local<v8::String> v8_source;
+    if (!v8::String::NewFromUtf8(isolate, source.data(),
+                                 v8::NewStringType::kNormal, source.size())
+             .ToLocal(&v8_source)) {
+      return v8::MaybeLocal<v8::Script>();
+    }
+    v8::ScriptCompiler::Source script_source(v8_source);
+    v8::Local<v8::UnboundScript> unbound_script;
+    if (!v8::ScriptCompiler::CompileUnboundScript(isolate, &script_source)
+             .ToLocal(&unbound_script)) {
+      return v8::MaybeLocal<v8::Script>();
+    }
+    g_provider_script->Reset(isolate, unbound_script);
+  }
+
+  return g_provider_script->Get(isolate)->BindToCurrentContext();
+}
+
 v8::MaybeLocal<v8::Value> GetProperty(v8::Local<v8::Context> context,
                                       v8::Local<v8::Value> object,
                                       const std::u16string& name) {
@@ -167,13 +191,9 @@ void OnGetAllowedAccounts(v8::Global<v8::Promise::Resolver> promise_resolver,
 namespace brave_wallet {
 
 BraveWalletJSHandler::BraveWalletJSHandler(content::RenderFrame* render_frame)
-    : render_frame_(render_frame), is_connected_(false) {
-  if (g_provider_script->empty()) {
-    *g_provider_script =
-        LoadDataResource(IDR_BRAVE_WALLET_SCRIPT_BRAVE_WALLET_SCRIPT_BUNDLE_JS);
-  }
-  EnsureConnected();
-}
+    : render_frame_(render_frame),
+      is_connected_(false),
+      is_provider_initialized_(false) {}
 
 BraveWalletJSHandler::~BraveWalletJSHandler() = default;
 
@@ -207,25 +227,112 @@ void BraveWalletJSHandler::AddJavaScriptObjectToFrame(
   v8::MicrotasksScope microtasks(isolate,
                                  v8::MicrotasksScope::kDoNotRunMicrotasks);
 
-  CreateEthereumObject(isolate, context);
-  InjectInitScript();
+  // Only a stub accessor is installed here. The provider object, the mojo
+  // connection and the provider script are set up on first access of
+  // window.ethereum, so pages which never use it pay none of those costs.
+  is_provider_initialized_ = false;
+  v8::Local<v8::Object> global = context->Global();
+  v8::Local<v8::Value> ethereum_value;
+  if (global->Get(context, gin::StringToV8(isolate, "ethereum"))
+          .ToLocal(&ethereum_value) &&
+      ethereum_value->IsObject()) {
+    return;
+  }
+  v8::Local<v8::Function> getter =
+      gin::CreateFunctionTemplate(
+          isolate,
+          base::BindRepeating(&BraveWalletJSHandler::OnEthereumPropertyGet,
+                              weak_ptr_factory_.GetWeakPtr()))
+          ->GetFunction(context)
+          .ToLocalChecked();
+  v8::Local<v8::Function> setter =
+      gin::CreateFunctionTemplate(
+          isolate,
+          base::BindRepeating(&BraveWalletJSHandler::OnEthereumPropertySet,
+                              weak_ptr_factory_.GetWeakPtr()))
+          ->GetFunction(context)
+          .ToLocalChecked();
+  global->SetAccessorProperty(gin::StringToSymbol(isolate, "ethereum"), getter,
+                              setter);
+}
+
+v8::MaybeLocal<v8::Context> BraveWalletJSHandler::GetHolderContext(
+    gin::Arguments* args) {
+  // The stub can be reached from another same-origin window, e.g. through
+  // iframe.contentWindow.ethereum, so the current context is the caller's
+  // rather than the one of the window owning window.ethereum.
+  v8::Local<v8::Context> context = args->GetHolderCreationContext();
+  if (context.IsEmpty() ||
+      blink::WebLocalFrame::FrameForContext(context) !=
+          render_frame_->GetWebFrame()) {
+    return v8::MaybeLocal<v8::Context>();
+  }
+
+  return context;
 }
 
-void BraveWalletJSHandler::CreateEthereumObject(
-    v8::Isolate* isolate, v8::Local<v8::Context> context) {
+// static
+void BraveWalletJSHandler::OnEthereumPropertyGet(
+    base::WeakPtr<BraveWalletJSHandler> handler,
+    gin::Arguments* args) {
+  if (!handler)
+    return;
+
+  v8::Local<v8::Context> context;
+  if (!handler->GetHolderContext(args).ToLocal(&context))
+    return;
+
+  v8::Context::Scope context_scope(context);
+  v8::Local<v8::Object> ethereum;
+  if (handler->CreateEthereumObject(args->isolate(), context)
+          .ToLocal(&ethereum)) {
+    args->Return(ethereum);
+  }
+}
+
+// static
+void BraveWalletJSHandler::OnEthereumPropertySet(
+    base::WeakPtr<BraveWalletJSHandler> handler,
+    gin::Arguments* args) {
+  if (!handler)
+    return;
+
+  v8::Local<v8::Context> context;
+  v8::Local<v8::Value> value;
+  if (!handler->GetHolderContext(args).ToLocal(&context) ||
+      !args->GetNext(&value)) {
+    return;
+  }
+
+  // The page replaced window.ethereum before using it, so the stub is
+  // swapped for a plain data property and the provider is never set up.
+  v8::Context::Scope context_scope(context);
   v8::Local<v8::Object> global = context->Global();
-  v8::Local<v8::Object> cosmetic_filters_obj;
-  v8::Local<v8::Value> cosmetic_filters_value;
-  if (!global->Get(context, gin::StringToV8(isolate, "ethereum"))
-           .ToLocal(&cosmetic_filters_value) ||
-      !cosmetic_filters_value->IsObject()) {
-    cosmetic_filters_obj = v8::Object::New(isolate);
-    global
-        ->Set(context, gin::StringToSymbol(isolate, "ethereum"),
-              cosmetic_filters_obj)
-        .Check();
-    BindFunctionsToObject(isolate, context, cosmetic_filters_obj);
+  v8::Local<v8::String> name =
+      gin::StringToSymbol(args->isolate(), "ethereum");
+  if (global->Delete(context, name).FromMaybe(false))
+    ALLOW_UNUSED_LOCAL(global->CreateDataProperty(context, name, value));
+}
+
+v8::MaybeLocal<v8::Object> BraveWalletJSHandler::CreateEthereumObject(
+    v8::Isolate* isolate,
+    v8::Local<v8::Context> context) {
+  v8::Local<v8::Object> global = context->Global();
+  v8::Local<v8::String> name = gin::StringToSymbol(isolate, "ethereum");
+  v8::Local<v8::Object> ethereum_obj = v8::Object::New(isolate);
+  BindFunctionsToObject(isolate, context, ethereum_obj);
+  // Replace the stub accessor before running the provider script, which
+  // reads window.ethereum itself.
+  if (!global->Delete(context, name).FromMaybe(false) ||
+      !global->CreateDataProperty(context, name, ethereum_obj)
+           .FromMaybe(false)) {
+    return v8::MaybeLocal<v8::Object>();
   }
+
+  InjectInitScript(isolate, context);
+  is_provider_initialized_ = true;
+  ConnectEvent();
+  return ethereum_obj;
 }
 
 void BraveWalletJSHandler::BindFunctionsToObject(
@@ -466,16 +573,17 @@ void BraveWalletJSHandler::OnSendAsync(
       callback_local, v8::Object::New(isolate), 2, argv);
 }
 
-void BraveWalletJSHandler::ExecuteScript(const std::string script) {
-  blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  if (web_frame->IsProvisional())
+void BraveWalletJSHandler::InjectInitScript(v8::Isolate* isolate,
+                                            v8::Local<v8::Context> context) {
+  if (render_frame_->GetWebFrame()->IsProvisional())
     return;
 
-  web_frame->ExecuteScript(blink::WebString::FromUTF8(script));
-}
+  v8::Local<v8::Script> script;
+  if (!GetProviderScript(isolate, context).ToLocal(&script))
+    return;
 
-void BraveWalletJSHandler::InjectInitScript() {
-  ExecuteScript(*g_provider_script);
+  v8::TryCatch try_catch(isolate);
+  ALLOW_UNUSED_LOCAL(script->Run(context));
 }
 
 void BraveWalletJSHandler::FireEvent(const std::string& event,
@@ -490,7 +598,8 @@ void BraveWalletJSHandler::FireEvent(const std::string& event,
 }
 
 void BraveWalletJSHandler::ConnectEvent() {
-  if (!EnsureConnected())
+  // The connect event is sent once the page starts using the provider.
+  if (!is_provider_initialized_ || !EnsureConnected())
     return;
 
   brave_wallet_provider_->GetChainId(base::BindOnce(
@@ -510,7 +619,9 @@ void BraveWalletJSHandler::DisconnectEvent(const std::string& message) {
 }
 
 void BraveWalletJSHandler::ChainChangedEvent(const std::string& chain_id) {
-  if (chain_id_ == chain_id)
+  // Firing the event would run the lazy window.ethereum getter on a page which
+  // hasn't used the provider yet.
+  if (!is_provider_initialized_ || chain_id_ == chain_id)
     return;
 
   base::DictionaryValue event_args;
@@ -47,12 +47,23 @@ class BraveWalletJSHandler : public mojom::EventsListener {
                             v8::Local<v8::Object> javascript_object,
                             const std::string& name,
                             const base::RepeatingCallback<Sig>& callback);
-  void CreateEthereumObject(v8::Isolate* isolate,
-                            v8::Local<v8::Context> context);
+  // Getter and setter of the window.ethereum stub. They are bound through a
+  // WeakPtr since the page can keep a window alive after its frame is gone.
+  static void OnEthereumPropertyGet(
+      base::WeakPtr<BraveWalletJSHandler> handler,
+      gin::Arguments* args);
+  static void OnEthereumPropertySet(
+      base::WeakPtr<BraveWalletJSHandler> handler,
+      gin::Arguments* args);
+  // Returns the context of the window holding the stub, or an empty handle if
+  // that window doesn't belong to this frame.
+  v8::MaybeLocal<v8::Context> GetHolderContext(gin::Arguments* args);
+  v8::MaybeLocal<v8::Object> CreateEthereumObject(
+      v8::Isolate* isolate,
+      v8::Local<v8::Context> context);
   bool EnsureConnected();
   void OnRemoteDisconnect();
-  void InjectInitScript();
-  void ExecuteScript(const std::string script);
+  void InjectInitScript(v8::Isolate* isolate, v8::Local<v8::Context> context);
 
   // Functions to be called from JS
   v8::Local<v8::Promise> Request(v8::Isolate* isolate,
@@ -76,6 +87,8 @@ class BraveWalletJSHandler : public mojom::EventsListener {
   mojo::Remote<mojom::BraveWalletProvider> brave_wallet_provider_;
   mojo::Receiver<mojom::EventsListener> receiver_{this};
   bool is_connected_;
+  // Whether window.ethereum has been accessed in the current document.
+  bool is_provider_initialized_;
   std::string chain_id_;
   base::WeakPtrFactory<BraveWalletJSHandler> weak_ptr_factory_{this};
 };
@@ -6,14 +6,15 @@
 #include "brave/components/cosmetic_filters/renderer/cosmetic_filters_js_handler.h"
 
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
-#include "base/json/json_writer.h"
 #include "base/no_destructor.h"
-#include "base/strings/stringprintf.h"
+#include "base/notreached.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/components/cosmetic_filters/resources/grit/cosmetic_filters_generated_map.h"
 #include "content/public/renderer/render_frame.h"
+#include "content/public/renderer/v8_value_converter.h"
 #include "gin/arguments.h"
 #include "gin/function_template.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -27,15 +28,15 @@
 
 namespace {
 
-static base::NoDestructor<std::string> g_observing_script("");
-
 static base::NoDestructor<std::vector<std::string>> g_vetted_search_engines(
     {"duckduckgo", "qwant", "bing", "startpage", "google", "yandex", "ecosia",
      "brave"});
 
+// Each of the scripts below evaluates to a function. Per-frame data is passed
+// to it as arguments so the source stays the same across frames and is only
+// compiled once per renderer, see GetCompiledFunction().
 const char kScriptletInitScript[] =
-    R"((function() {
-          let text = %s;
+    R"((function(text) {
           let script;
           try {
             script = document.createElement('script');
@@ -51,29 +52,25 @@ const char kScriptletInitScript[] =
             }
             script.textContent = '';
           }
-        })();)";
+        }))";
 
 const char kPreInitScript[] =
-    R"((function() {
+    R"((function(hide1pContent, generichide) {
           if (window.content_cosmetic == undefined) {
             window.content_cosmetic = {};
           }
-          %s
-        })();)";
-
-const char kCosmeticFilteringInitScript[] =
-    R"(if (window.content_cosmetic.hide1pContent === undefined) {
-        window.content_cosmetic.hide1pContent = %s;
-       }
-       if (window.content_cosmetic.generichide === undefined) {
-         window.content_cosmetic.generichide = %s;
-       })";
+          if (window.content_cosmetic.hide1pContent === undefined) {
+            window.content_cosmetic.hide1pContent = hide1pContent;
+          }
+          if (window.content_cosmetic.generichide === undefined) {
+            window.content_cosmetic.generichide = generichide;
+          }
+        }))";
 
 const char kHideSelectorsInjectScript[] =
-    R"((function() {
+    R"((function(selectors) {
           let nextIndex =
               window.content_cosmetic.cosmeticStyleSheet.rules.length;
-          const selectors = %s;
           selectors.forEach(selector => {
             if ((typeof selector === 'string') &&
                 (window.content_cosmetic.hide1pContent ||
@@ -95,13 +92,12 @@ const char kHideSelectorsInjectScript[] =
               [window.content_cosmetic.cosmeticStyleSheet,
                 ...document.adoptedStyleSheets];
           };
-        })();)";
+        }))";
 
 const char kForceHideSelectorsInjectScript[] =
-    R"((function() {
+    R"((function(selectors) {
           let nextIndex =
               window.content_cosmetic.cosmeticStyleSheet.rules.length;
-          const selectors = %s;
           selectors.forEach(selector => {
             if (typeof selector === 'string') {
               let rule = selector + '{display:none !important;}';
@@ -120,13 +116,12 @@ const char kForceHideSelectorsInjectScript[] =
               [window.content_cosmetic.cosmeticStyleSheet,
                 ...document.adoptedStyleSheets];
           };
-        })();)";
+        }))";
 
 const char kStyleSelectorsInjectScript[] =
-    R"((function() {
+    R"((function(selectors) {
           let nextIndex =
               window.content_cosmetic.cosmeticStyleSheet.rules.length;
-          const selectors = %s;
           for (let selector in selectors) {
             if (window.content_cosmetic.hide1pContent ||
                 !window.content_cosmetic.allSelectorsToRules.has(selector)) {
@@ -153,7 +148,7 @@ const char kStyleSelectorsInjectScript[] =
                [window.content_cosmetic.cosmeticStyleSheet,
                  ...document.adoptedStyleSheets];
           };
-        })();)";
+        }))";
 
 std::string LoadDataResource(const int id) {
   auto& resource_bundle = ui::ResourceBundle::GetSharedInstance();
@@ -183,6 +178,75 @@ bool IsVettedSearchEngine(const GURL& url) {
   return false;
 }
 
+std::string GetScriptSource(cosmetic_filters::CosmeticFiltersScript script) {
+  using cosmetic_filters::CosmeticFiltersScript;
+  switch (script) {
+    case CosmeticFiltersScript::kPreInit:
+      return kPreInitScript;
+    case CosmeticFiltersScript::kScriptletInit:
+      return kScriptletInitScript;
+    case CosmeticFiltersScript::kHideSelectors:
+      return kHideSelectorsInjectScript;
+    case CosmeticFiltersScript::kForceHideSelectors:
+      return kForceHideSelectorsInjectScript;
+    case CosmeticFiltersScript::kStyleSelectors:
+      return kStyleSelectorsInjectScript;
+    case CosmeticFiltersScript::kObserving:
+      // The bundle runs as a plain function body so that it can be compiled
+      // and cached like the other scripts.
+      return "(function() {\n" +
+             LoadDataResource(kCosmeticFiltersGenerated[0].id) + "\n})";
+    case CosmeticFiltersScript::kCount:
+      break;
+  }
+  NOTREACHED();
+  return std::string();
+}
+
+// Compiled scripts are shared by all frames of the renderer, which only ever
+// runs them on the main thread isolate.
+std::vector<v8::Global<v8::UnboundScript>>& GetCompiledScripts() {
+  static base::NoDestructor<std::vector<v8::Global<v8::UnboundScript>>>
+      compiled_scripts(
+          static_cast<size_t>(cosmetic_filters::CosmeticFiltersScript::kCount));
+  return *compiled_scripts;
+}
+
+// Returns the function |script| evaluates to in |context|, compiling the
+// script on first use.
+v8::MaybeLocal<v8::Function> GetCompiledFunction(
+    v8::Isolate* isolate,
+    v8::Local<v8::Context> context,
+    cosmetic_filters::CosmeticFiltersScript script) {
+  v8::Global<v8::UnboundScript>& compiled =
+      GetCompiledScripts()[static_cast<size_t>(script)];
+  if (compiled.IsEmpty()) {
+    const std::string source = GetScriptSource(script);
+    v8::Local<v8::String> v8_source;
+    if (!v8::String::NewFromUtf8(isolate, source.data(),
+                                 v8::NewStringType::kNormal, source.size())
+             .ToLocal(&v8_source)) {
+      return v8::MaybeLocal<v8::Function>();
+    }
+    v8::ScriptCompiler::Source script_source(v8_source);
+    v8::Local<v8::UnboundScript> unbound_script;
+    if (!v8::ScriptCompiler::CompileUnboundScript(
+             isolate, &script_source, v8::ScriptCompiler::kEagerCompile)
+             .ToLocal(&unbound_script)) {
+      return v8::MaybeLocal<v8::Function>();
+    }
+    compiled.Reset(isolate, unbound_script);
+  }
+
+  v8::Local<v8::Value> function;
+  if (!compiled.Get(isolate)->BindToCurrentContext()->Run(context).ToLocal(
+          &function) ||
+      !function->IsFunction()) {
+    return v8::MaybeLocal<v8::Function>();
+  }
+  return function.As<v8::Function>();
+}
+
 }  // namespace
 
 namespace cosmetic_filters {
@@ -193,9 +257,6 @@ CosmeticFiltersJSHandler::CosmeticFiltersJSHandler(
     : render_frame_(render_frame),
       isolated_world_id_(isolated_world_id),
       enabled_1st_party_cf_(false) {
-  if (g_observing_script->empty()) {
-    *g_observing_script = LoadDataResource(kCosmeticFiltersGenerated[0].id);
-  }
   EnsureConnected();
 }
 
@@ -325,17 +386,13 @@ void CosmeticFiltersJSHandler::ApplyRules() {
   if (!resources_dict_ || web_frame->IsProvisional())
     return;
 
-  std::string scriptlet_script;
-  base::Value* injected_script = resources_dict_->FindPath("injected_script");
-  if (injected_script &&
-      base::JSONWriter::Write(*injected_script, &scriptlet_script)) {
-    scriptlet_script =
-        base::StringPrintf(kScriptletInitScript, scriptlet_script.c_str());
-  }
-  if (!scriptlet_script.empty()) {
-    web_frame->ExecuteScriptInIsolatedWorld(
-        isolated_world_id_, blink::WebString::FromUTF8(scriptlet_script),
-        blink::BackForwardCacheAware::kAllow);
+  const base::Value* injected_script =
+      resources_dict_->FindPath("injected_script");
+  if (injected_script && injected_script->is_string() &&
+      !injected_script->GetString().empty()) {
+    base::Value args(base::Value::Type::LIST);
+    args.Append(injected_script->Clone());
+    ExecuteScript(CosmeticFiltersScript::kScriptletInit, std::move(args));
   }
 
   if (!render_frame_->IsMainFrame())
@@ -344,22 +401,46 @@ void CosmeticFiltersJSHandler::ApplyRules() {
   // Working on css rules, we do that on a main frame only
   bool generichide = false;
   resources_dict_->GetBoolean("generichide", &generichide);
-  std::string cosmetic_filtering_init_script = base::StringPrintf(
-      kCosmeticFilteringInitScript, enabled_1st_party_cf_ ? "true" : "false",
-      generichide ? "true" : "false");
-  std::string pre_init_script = base::StringPrintf(
-      kPreInitScript, cosmetic_filtering_init_script.c_str());
-
-  web_frame->ExecuteScriptInIsolatedWorld(
-      isolated_world_id_, blink::WebString::FromUTF8(pre_init_script),
-      blink::BackForwardCacheAware::kAllow);
-  web_frame->ExecuteScriptInIsolatedWorld(
-      isolated_world_id_, blink::WebString::FromUTF8(*g_observing_script),
-      blink::BackForwardCacheAware::kAllow);
+  base::Value args(base::Value::Type::LIST);
+  args.Append(enabled_1st_party_cf_);
+  args.Append(generichide);
+  ExecuteScript(CosmeticFiltersScript::kPreInit, std::move(args));
+  ExecuteScript(CosmeticFiltersScript::kObserving,
+                base::Value(base::Value::Type::LIST));
 
   CSSRulesRoutine(resources_dict_.get());
 }
 
+void CosmeticFiltersJSHandler::ExecuteScript(CosmeticFiltersScript script,
+                                             base::Value args) {
+  blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
+  if (web_frame->IsProvisional())
+    return;
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Context> context =
+      web_frame->GetScriptContextFromWorldId(isolate, isolated_world_id_);
+  if (context.IsEmpty())
+    return;
+
+  v8::Context::Scope context_scope(context);
+  v8::MicrotasksScope microtasks(isolate,
+                                 v8::MicrotasksScope::kDoNotRunMicrotasks);
+  v8::Local<v8::Function> function;
+  if (!GetCompiledFunction(isolate, context, script).ToLocal(&function))
+    return;
+
+  std::vector<v8::Local<v8::Value>> v8_args;
+  for (const auto& arg : args.GetList()) {
+    v8_args.push_back(
+        content::V8ValueConverter::Create()->ToV8Value(&arg, context));
+  }
+  web_frame->ExecuteMethodAndReturnValue(function, context->Global(),
+                                         static_cast<int>(v8_args.size()),
+                                         v8_args.data());
+}
+
 void CosmeticFiltersJSHandler::CSSRulesRoutine(
     base::DictionaryValue* resources_dict) {
   // Otherwise, if its a vetted engine AND we're not in aggressive
@@ -367,7 +448,6 @@ void CosmeticFiltersJSHandler::CSSRulesRoutine(
   if (!enabled_1st_party_cf_ && IsVettedSearchEngine(url_))
     return;
 
-  blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
   base::ListValue* cf_exceptions_list;
   if (resources_dict->GetList("exceptions", &cf_exceptions_list)) {
     for (size_t i = 0; i < cf_exceptions_list->GetSize(); i++) {
@@ -385,55 +465,28 @@ void CosmeticFiltersJSHandler::CSSRulesRoutine(
   }
 
   if (hide_selectors_list && hide_selectors_list->GetSize() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
-    // Building a script for stylesheet modifications
-    std::string new_selectors_script =
-        base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
-    web_frame->ExecuteScriptInIsolatedWorld(
-        isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
-        blink::BackForwardCacheAware::kAllow);
+    base::Value args(base::Value::Type::LIST);
+    args.Append(hide_selectors_list->Clone());
+    ExecuteScript(CosmeticFiltersScript::kHideSelectors, std::move(args));
   }
 
   if (force_hide_selectors_list && force_hide_selectors_list->GetSize() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*force_hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
-    // Building a script for stylesheet modifications
-    std::string new_selectors_script = base::StringPrintf(
-        kForceHideSelectorsInjectScript, json_selectors.c_str());
-    web_frame->ExecuteScriptInIsolatedWorld(
-        isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
-        blink::BackForwardCacheAware::kAllow);
+    base::Value args(base::Value::Type::LIST);
+    args.Append(force_hide_selectors_list->Clone());
+    ExecuteScript(CosmeticFiltersScript::kForceHideSelectors, std::move(args));
   }
 
   base::DictionaryValue* style_selectors_dictionary = nullptr;
   if (resources_dict->GetDictionary("style_selectors",
                                     &style_selectors_dictionary)) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*style_selectors_dictionary,
-                                 &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
-    std::string new_selectors_script =
-        base::StringPrintf(kStyleSelectorsInjectScript, json_selectors.c_str());
-    if (!json_selectors.empty()) {
-      web_frame->ExecuteScriptInIsolatedWorld(
-          isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
-          blink::BackForwardCacheAware::kAllow);
-    }
+    base::Value args(base::Value::Type::LIST);
+    args.Append(style_selectors_dictionary->Clone());
+    ExecuteScript(CosmeticFiltersScript::kStyleSelectors, std::move(args));
   }
 
   if (!enabled_1st_party_cf_) {
-    web_frame->ExecuteScriptInIsolatedWorld(
-        isolated_world_id_, blink::WebString::FromUTF8(*g_observing_script),
-        blink::BackForwardCacheAware::kAllow);
+    ExecuteScript(CosmeticFiltersScript::kObserving,
+                  base::Value(base::Value::Type::LIST));
   }
 }
 
@@ -450,25 +503,15 @@ void CosmeticFiltersJSHandler::OnHiddenClassIdSelectors(base::Value result) {
   if (!result.GetAsList(&selectors_list))
     return;
 
-  blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  std::string json_selectors;
-  if (!base::JSONWriter::Write(*selectors_list, &json_selectors) ||
-      json_selectors.empty()) {
-    json_selectors = "[]";
-  }
-  // Building a script for stylesheet modifications
-  std::string new_selectors_script =
-      base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
   if (selectors_list->GetSize() != 0) {
-    web_frame->ExecuteScriptInIsolatedWorld(
-        isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
-        blink::BackForwardCacheAware::kAllow);
+    base::Value args(base::Value::Type::LIST);
+    args.Append(selectors_list->Clone());
+    ExecuteScript(CosmeticFiltersScript::kHideSelectors, std::move(args));
   }
 
   if (!enabled_1st_party_cf_) {
-    web_frame->ExecuteScriptInIsolatedWorld(
-        isolated_world_id_, blink::WebString::FromUTF8(*g_observing_script),
-        blink::BackForwardCacheAware::kAllow);
+    ExecuteScript(CosmeticFiltersScript::kObserving,
+                  base::Value(base::Value::Type::LIST));
   }
 }
 
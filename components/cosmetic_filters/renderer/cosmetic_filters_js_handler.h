@@ -20,6 +20,18 @@
 
 namespace cosmetic_filters {
 
+// Scripts injected into the isolated world. Each one is compiled once per
+// renderer and called with per-frame data as arguments.
+enum class CosmeticFiltersScript {
+  kPreInit,
+  kScriptletInit,
+  kHideSelectors,
+  kForceHideSelectors,
+  kStyleSelectors,
+  kObserving,
+  kCount
+};
+
 // CosmeticFiltersJSHandler class is responsible for JS execution inside a
 // a given render_frame. It also does interactions with CosmeticFiltersResources
 // class that lives in the main process.
@@ -59,6 +71,9 @@ class CosmeticFiltersJSHandler {
                                    bool first_party_enabled);
   void OnUrlCosmeticResources(base::OnceClosure callback, base::Value result);
   void CSSRulesRoutine(base::DictionaryValue* resources_dict);
+  // Runs |script| in the isolated world, passing the items of the |args| list
+  // as arguments.
+  void ExecuteScript(CosmeticFiltersScript script, base::Value args);
   void OnHiddenClassIdSelectors(base::Value result);
 
   content::RenderFrame* render_frame_;
@@ -291,6 +291,14 @@ interface BlockDetails {
   tabId: number
   subresource: string
 }
+
+interface BlockedResourcesDetails {
+  tabId: number
+  blocked: Array<{
+    blockType: BlockTypes
+    subresources: string[]
+  }>
+}
 declare namespace chrome.tabs {
   const setAsync: any
   const getAsync: any
@@ -302,8 +310,8 @@ declare namespace chrome.windows {
 
 declare namespace chrome.braveShields {
   const onBlocked: {
-    addListener: (callback: (detail: BlockDetails) => void) => void
-    emit: (detail: BlockDetails) => void
+    addListener: (callback: (details: BlockedResourcesDetails) => void) => void
+    emit: (details: BlockedResourcesDetails) => void
   }
 
   const allowScriptsOnce: any
@@ -11,7 +11,6 @@
 #include "base/files/file_util.h"
 #include "base/guid.h"
 #include "base/strings/strcat.h"
-#include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
@@ -42,6 +41,30 @@
 
 namespace {
 
+// Entries of the add response are small, a line longer than this can't be
+// one and is skipped.
+constexpr size_t kMaxAddResponseLineSize = 64 * 1024;
+
+// Responses to the commands following the add are a single short JSON object.
+constexpr size_t kMaxCommandResponseSize = 64 * 1024;
+
+// The add response is JSON encoded by the node, so the raw line can only be
+// searched for names without characters that may be escaped. The name is
+// searched for as a whole JSON string, so that the entries of files inside a
+// folder, named "<folder>/<file>", don't match the folder. Returns true if
+// the line needs to be parsed to find out whether it is the entry for |name|.
+bool MayContainName(base::StringPiece line, const std::string& name) {
+  for (const char c : name) {
+    const unsigned char byte = static_cast<unsigned char>(c);
+    if (byte < 0x20 || byte >= 0x80 || c == '"' || c == '\\' || c == '<' ||
+        c == '>' || c == '&') {
+      return true;
+    }
+  }
+  return line.find(base::StrCat({"\"", name, "\""})) !=
+         base::StringPiece::npos;
+}
+
 // Return a date string formatted as "YYYY-MM-DD".
 std::string TimeFormatDate(const base::Time& time) {
   base::Time::Exploded exploded_time;
@@ -134,45 +157,31 @@ void IpfsImportWorkerBase::UploadData(
   DCHECK(!url_loader_);
   url_loader_ = CreateURLLoader(url, "POST", std::move(request));
 
-  url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
-      url_loader_factory_,
-      base::BindOnce(&IpfsImportWorkerBase::OnImportAddComplete,
-                     weak_factory_.GetWeakPtr()));
+  // The response has a line for every imported file, so it is parsed as it
+  // arrives instead of being buffered.
+  ResetAddResponse();
+  url_loader_->DownloadAsStream(url_loader_factory_, this);
 }
 
-bool IpfsImportWorkerBase::ParseResponseBody(const std::string& response_body,
-                                             ipfs::ImportedData* data) {
-  DCHECK(data);
-  std::vector<std::string> parts = base::SplitString(
-      response_body, "\n", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
-  if (!parts.size())
-    return IPFSJSONParser::GetImportResponseFromJSON(response_body, data);
-  for (const auto& item : parts) {
-    if (item.front() != '{' || item.back() != '}')
-      continue;
-    ipfs::ImportedData imported_item;
-    if (IPFSJSONParser::GetImportResponseFromJSON(item, &imported_item)) {
-      if (imported_item.filename != data->filename)
-        continue;
-      data->hash = imported_item.hash;
-      data->size = imported_item.size;
-      return true;
-    }
-  }
-  return false;
+void IpfsImportWorkerBase::OnDataReceived(base::StringPiece string_piece,
+                                          base::OnceClosure resume) {
+  ParseAddResponseChunk(string_piece);
+  std::move(resume).Run();
 }
 
-void IpfsImportWorkerBase::OnImportAddComplete(
-    std::unique_ptr<std::string> response_body) {
+void IpfsImportWorkerBase::OnComplete(bool success) {
   int error_code = url_loader_->NetError();
   int response_code = -1;
   if (url_loader_->ResponseInfo() && url_loader_->ResponseInfo()->headers)
     response_code = url_loader_->ResponseInfo()->headers->response_code();
 
-  bool success = (error_code == net::OK && response_code == net::HTTP_OK);
-  if (success) {
-    success = ParseResponseBody(*response_body, data_.get());
+  success = (error_code == net::OK && response_code == net::HTTP_OK);
+  if (success && !add_response_found_ && !add_response_line_overflow_) {
+    // The last line may not be terminated.
+    add_response_found_ = ParseAddResponseLine(add_response_line_);
   }
+  success = success && add_response_found_;
+  ResetAddResponse();
   url_loader_.reset();
   if (success && !data_->hash.empty()) {
     CreateBraveDirectory();
@@ -181,6 +190,64 @@ void IpfsImportWorkerBase::OnImportAddComplete(
   NotifyImportCompleted(IPFS_IMPORT_ERROR_ADD_FAILED);
 }
 
+void IpfsImportWorkerBase::OnRetry(base::OnceClosure start_retry) {
+  ResetAddResponse();
+  std::move(start_retry).Run();
+}
+
+void IpfsImportWorkerBase::ParseAddResponseChunk(base::StringPiece chunk) {
+  // Once the entry is found the rest of the response is only drained, the
+  // node may still be importing and cancelling the request would abort it.
+  while (!add_response_found_ && !chunk.empty()) {
+    size_t line_end = chunk.find('\n');
+    if (line_end == base::StringPiece::npos) {
+      AppendToAddResponseLine(chunk);
+      return;
+    }
+    AppendToAddResponseLine(chunk.substr(0, line_end));
+    if (!add_response_line_overflow_)
+      add_response_found_ = ParseAddResponseLine(add_response_line_);
+    add_response_line_.clear();
+    add_response_line_overflow_ = false;
+    chunk.remove_prefix(line_end + 1);
+  }
+}
+
+void IpfsImportWorkerBase::AppendToAddResponseLine(base::StringPiece piece) {
+  if (add_response_line_overflow_)
+    return;
+  if (add_response_line_.size() + piece.size() > kMaxAddResponseLineSize) {
+    add_response_line_overflow_ = true;
+    add_response_line_.clear();
+    return;
+  }
+  add_response_line_.append(piece.data(), piece.size());
+}
+
+bool IpfsImportWorkerBase::ParseAddResponseLine(const std::string& line) {
+  base::StringPiece item = base::TrimWhitespaceASCII(line, base::TRIM_ALL);
+  if (item.empty() || item.front() != '{' || item.back() != '}')
+    return false;
+  if (!MayContainName(item, data_->filename))
+    return false;
+  ipfs::ImportedData imported_item;
+  if (!IPFSJSONParser::GetImportResponseFromJSON(std::string(item),
+                                                 &imported_item)) {
+    return false;
+  }
+  if (imported_item.filename != data_->filename)
+    return false;
+  data_->hash = imported_item.hash;
+  data_->size = imported_item.size;
+  return true;
+}
+
+void IpfsImportWorkerBase::ResetAddResponse() {
+  add_response_line_.clear();
+  add_response_line_overflow_ = false;
+  add_response_found_ = false;
+}
+
 void IpfsImportWorkerBase::CreateBraveDirectory() {
   DCHECK(!url_loader_);
   GURL url = net::AppendQueryParameter(
@@ -191,10 +258,11 @@ void IpfsImportWorkerBase::CreateBraveDirectory() {
   url = net::AppendQueryParameter(url, "arg", directory);
 
   url_loader_ = CreateURLLoader(url, "POST");
-  url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+  url_loader_->DownloadToString(
       url_loader_factory_,
       base::BindOnce(&IpfsImportWorkerBase::OnImportDirectoryCreated,
-                     base::Unretained(this), directory));
+                     base::Unretained(this), directory),
+      kMaxCommandResponseSize);
 }
 
 void IpfsImportWorkerBase::OnImportDirectoryCreated(
@@ -223,10 +291,11 @@ void IpfsImportWorkerBase::CopyFilesToBraveDirectory() {
   url = net::AppendQueryParameter(url, "arg", to);
 
   url_loader_ = CreateURLLoader(url, "POST");
-  url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+  url_loader_->DownloadToString(
       url_loader_factory_,
       base::BindOnce(&IpfsImportWorkerBase::OnImportFilesMoved,
-                     base::Unretained(this)));
+                     base::Unretained(this)),
+      kMaxCommandResponseSize);
 }
 
 void IpfsImportWorkerBase::OnImportFilesMoved(
@@ -239,7 +308,8 @@ void IpfsImportWorkerBase::OnImportFilesMoved(
   bool success = (error_code == net::OK && response_code == net::HTTP_OK);
   if (!success) {
     VLOG(1) << "error_code:" << error_code << " response_code:" << response_code
-            << " response_body:" << *response_body;
+            << " response_body:"
+            << (response_body ? *response_body : std::string());
   }
   if (!data_->hash.empty() && !key_to_publish_.empty()) {
     PublishContent();
@@ -257,10 +327,11 @@ void IpfsImportWorkerBase::PublishContent() {
   url = net::AppendQueryParameter(url, "key", key_to_publish_);
 
   url_loader_ = CreateURLLoader(url, "POST");
-  url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+  url_loader_->DownloadToString(
       url_loader_factory_,
       base::BindOnce(&IpfsImportWorkerBase::OnContentPublished,
-                     base::Unretained(this)));
+                     base::Unretained(this)),
+      kMaxCommandResponseSize);
 }
 
 void IpfsImportWorkerBase::OnContentPublished(
@@ -275,7 +346,8 @@ void IpfsImportWorkerBase::OnContentPublished(
     data_->published_key = key_to_publish_;
   if (!success) {
     VLOG(1) << "error_code:" << error_code << " response_code:" << response_code
-            << " response_body:" << *response_body;
+            << " response_body:"
+            << (response_body ? *response_body : std::string());
   }
 
   NotifyImportCompleted(success ? IPFS_IMPORT_SUCCESS
@@ -16,10 +16,12 @@
 #include "base/containers/queue.h"
 #include "base/files/file_util.h"
 #include "base/memory/scoped_refptr.h"
+#include "base/strings/string_piece.h"
 #include "brave/components/ipfs/blob_context_getter_factory.h"
 #include "brave/components/ipfs/import/imported_data.h"
 #include "brave/components/ipfs/ipfs_network_utils.h"
 #include "components/version_info/channel.h"
+#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
 #include "url/gurl.h"
 
 namespace network {
@@ -38,18 +40,19 @@ namespace ipfs {
 // Worker:
 //   1. Worker prepares a blob block of data to import
 // IpfsImportWorkerBase:
-//   2. Sends blob to ifps using IPFS api (/api/v0/add)
+//   2. Sends blob to ifps using IPFS api (/api/v0/add), the response is
+//      streamed line by line until the entry for the imported object is found
 //   3. Creates target directory for import using IPFS api(/api/v0/files/mkdir)
 //   4. Moves objects to target directory using IPFS api(/api/v0/files/cp)
 //   5. Publishes objects under passed IPNS key(/api/v0/name/publish)
-class IpfsImportWorkerBase {
+class IpfsImportWorkerBase : public network::SimpleURLLoaderStreamConsumer {
  public:
   IpfsImportWorkerBase(BlobContextGetterFactory* blob_context_getter_factory,
                        network::mojom::URLLoaderFactory* url_loader_factory,
                        const GURL& endpoint,
                        ImportCompletedCallback callback,
                        const std::string& key = std::string());
-  virtual ~IpfsImportWorkerBase();
+  ~IpfsImportWorkerBase() override;
 
   IpfsImportWorkerBase(const IpfsImportWorkerBase&) = delete;
   IpfsImportWorkerBase& operator=(const IpfsImportWorkerBase&) = delete;
@@ -67,17 +70,26 @@ class IpfsImportWorkerBase {
   virtual void NotifyImportCompleted(ipfs::ImportState state);
 
  private:
+  friend class IpfsImportWorkerBaseTest;
+
   void UploadData(std::unique_ptr<network::ResourceRequest> request);
 
-  void OnImportAddComplete(std::unique_ptr<std::string> response_body);
+  // network::SimpleURLLoaderStreamConsumer
+  void OnDataReceived(base::StringPiece string_piece,
+                      base::OnceClosure resume) override;
+  void OnComplete(bool success) override;
+  void OnRetry(base::OnceClosure start_retry) override;
+
+  void ParseAddResponseChunk(base::StringPiece chunk);
+  void AppendToAddResponseLine(base::StringPiece piece);
+  bool ParseAddResponseLine(const std::string& line);
+  void ResetAddResponse();
 
   void CreateBraveDirectory();
   void OnImportDirectoryCreated(const std::string& directory,
                                 std::unique_ptr<std::string> response_body);
   void CopyFilesToBraveDirectory();
   void OnImportFilesMoved(std::unique_ptr<std::string> response_body);
-  bool ParseResponseBody(const std::string& response_body,
-                         ipfs::ImportedData* data);
   void PublishContent();
   void OnContentPublished(std::unique_ptr<std::string> response_body);
   ImportCompletedCallback callback_;
@@ -88,6 +100,10 @@ class IpfsImportWorkerBase {
   std::unique_ptr<network::SimpleURLLoader> url_loader_;
   GURL server_endpoint_;
   std::string key_to_publish_;
+  // Incomplete trailing line of the add response
+  std::string add_response_line_;
+  bool add_response_line_overflow_ = false;
+  bool add_response_found_ = false;
   base::WeakPtrFactory<IpfsImportWorkerBase> weak_factory_;
 };
 
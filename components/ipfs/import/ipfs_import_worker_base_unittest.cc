@@ -0,0 +1,95 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/import/ipfs_import_worker_base.h"
+
+#include <memory>
+#include <string>
+
+#include "base/callback_helpers.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+constexpr char kFolderName[] = "folder";
+constexpr char kFolderEntry[] =
+    R"({"Name":"folder","Hash":"QmFolder","Size":"1234"})";
+
+std::string GetFileEntries(int count) {
+  std::string entries;
+  for (int i = 0; i < count; i++) {
+    entries += base::StringPrintf(
+        R"({"Name":"folder/file_%d","Hash":"QmFile%d","Size":"10"})"
+        "\n",
+        i, i);
+  }
+  return entries;
+}
+
+}  // namespace
+
+namespace ipfs {
+
+class IpfsImportWorkerBaseTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    worker_ = std::make_unique<IpfsImportWorkerBase>(
+        nullptr, nullptr, GURL("http://localhost:45001"), base::DoNothing());
+    worker_->data_->filename = kFolderName;
+  }
+
+  void ReceiveData(const std::string& data) {
+    static_cast<network::SimpleURLLoaderStreamConsumer*>(worker_.get())
+        ->OnDataReceived(data, base::DoNothing());
+  }
+
+  bool found() const { return worker_->add_response_found_; }
+  const ImportedData& data() const { return *worker_->data_; }
+
+ private:
+  base::test::TaskEnvironment task_environment_;
+  std::unique_ptr<IpfsImportWorkerBase> worker_;
+};
+
+TEST_F(IpfsImportWorkerBaseTest, FindsEntrySplitAcrossChunks) {
+  const std::string response =
+      GetFileEntries(3) + kFolderEntry + "\n" + GetFileEntries(1);
+  const size_t split = response.find("QmFolder");
+  ASSERT_NE(split, std::string::npos);
+
+  ReceiveData(response.substr(0, split));
+  EXPECT_FALSE(found());
+
+  ReceiveData(response.substr(split));
+  EXPECT_TRUE(found());
+  EXPECT_EQ(data().hash, "QmFolder");
+  EXPECT_EQ(data().size, 1234);
+}
+
+TEST_F(IpfsImportWorkerBaseTest, DoesNotMatchEntriesOfFilesInFolder) {
+  ReceiveData(GetFileEntries(10));
+  EXPECT_FALSE(found());
+  EXPECT_TRUE(data().hash.empty());
+}
+
+TEST_F(IpfsImportWorkerBaseTest, SkipsLinesOver64KB) {
+  // A line over the limit is dropped even though it names the folder, and
+  // the line following it is still parsed.
+  const std::string long_line =
+      R"({"Name":"folder","Hash":"QmLongLine","Size":"1","Padding":")" +
+      std::string(64 * 1024, 'x') + "\"}\n";
+  ReceiveData(long_line.substr(0, long_line.size() / 2));
+  ReceiveData(long_line.substr(long_line.size() / 2));
+  EXPECT_FALSE(found());
+
+  ReceiveData(std::string(kFolderEntry) + "\n");
+  EXPECT_TRUE(found());
+  EXPECT_EQ(data().hash, "QmFolder");
+}
+
+}  // namespace ipfs
@@ -57,16 +57,6 @@ net::NetworkTrafficAnnotationTag GetIpfsNetworkTrafficAnnotationTag() {
 }
 
 #if BUILDFLAG(ENABLE_IPFS_LOCAL_NODE)
-struct ImportFileInfo {
-  ImportFileInfo(base::FilePath full_path,
-                 base::FileEnumerator::FileInfo information) {
-    path = full_path;
-    info = information;
-  }
-  base::FilePath path;
-  base::FileEnumerator::FileInfo info;
-};
-
 bool GetRelativePathComponent(const base::FilePath& parent,
                               const base::FilePath& child,
                               base::FilePath::StringType* out) {
@@ -135,32 +125,44 @@ std::unique_ptr<storage::BlobDataBuilder> BuildBlobWithFile(
   return blob_builder;
 }
 
+// Appends every file and directory under |folder_path| to the blob while
+// enumerating it, so that large folders aren't held as a list of entries.
+// Multipart headers between files are coalesced into a single data element.
 std::unique_ptr<storage::BlobDataBuilder> BuildBlobWithFolder(
-    base::FilePath upload_path,
-    std::string mime_boundary,
-    std::vector<ImportFileInfo> files) {
+    base::FilePath folder_path,
+    std::string mime_boundary) {
+  const base::FilePath upload_path = folder_path.DirName();
   auto blob_builder =
       std::make_unique<storage::BlobDataBuilder>(base::GenerateGUID());
-  for (const auto& info : files) {
-    std::string data_header;
+  std::string data;
+  base::FileEnumerator file_enum(
+      folder_path, true,
+      base::FileEnumerator::FILES | base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath enum_path = file_enum.Next(); !enum_path.empty();
+       enum_path = file_enum.Next()) {
+    // Skip symlinks.
+    if (base::IsLink(enum_path))
+      continue;
+    const base::FileEnumerator::FileInfo info = file_enum.GetInfo();
     base::FilePath::StringType relative_path;
-    GetRelativePathComponent(upload_path, info.path, &relative_path);
+    GetRelativePathComponent(upload_path, enum_path, &relative_path);
 
-    std::string mime_type = info.info.IsDirectory() ? ipfs::kDirectoryMimeType
-                                                    : ipfs::kFileMimeType;
-    data_header.append("\r\n");
+    std::string mime_type = info.IsDirectory() ? ipfs::kDirectoryMimeType
+                                               : ipfs::kFileMimeType;
+    data.append("\r\n");
     ipfs::AddMultipartHeaderForUploadWithFileName(
         ipfs::kFileValueName, base::FilePath(relative_path).MaybeAsASCII(),
-        info.path.MaybeAsASCII(), mime_boundary, mime_type, &data_header);
-    blob_builder->AppendData(data_header);
+        enum_path.MaybeAsASCII(), mime_boundary, mime_type, &data);
     if (mime_type == ipfs::kFileMimeType) {
-      blob_builder->AppendFile(info.path, 0, info.info.GetSize(), base::Time());
+      blob_builder->AppendData(data);
+      data.clear();
+      blob_builder->AppendFile(enum_path, 0, info.GetSize(), base::Time());
     }
   }
 
-  std::string post_data_footer = "\r\n";
-  net::AddMultipartFinalDelimiterForUpload(mime_boundary, &post_data_footer);
-  blob_builder->AppendData(post_data_footer);
+  data.append("\r\n");
+  net::AddMultipartFinalDelimiterForUpload(mime_boundary, &data);
+  blob_builder->AppendData(data);
 
   return blob_builder;
 }
@@ -270,35 +272,16 @@ void CreateRequestForFile(
       std::move(request_callback));
 }
 
-std::vector<ImportFileInfo> EnumerateDirectoryFiles(base::FilePath dir_path) {
-  std::vector<ImportFileInfo> files;
-  base::FileEnumerator file_enum(
-      dir_path, true,
-      base::FileEnumerator::FILES | base::FileEnumerator::DIRECTORIES);
-  for (base::FilePath enum_path = file_enum.Next(); !enum_path.empty();
-       enum_path = file_enum.Next()) {
-    // Skip symlinks.
-    if (base::IsLink(enum_path))
-      continue;
-    files.push_back(ImportFileInfo(enum_path, file_enum.GetInfo()));
-  }
-
-  return files;
-}
-
-void CreateRequestForFileList(
+void CreateRequestForFolderBlob(
     ResourceRequestGetter request_callback,
     ipfs::BlobContextGetterFactory* blob_context_getter_factory,
-    const base::FilePath& folder_path,
-    std::vector<ImportFileInfo> files) {
-  std::string mime_boundary = net::GenerateMimeMultipartBoundary();
-  auto blob_builder_callback =
-      base::BindOnce(&BuildBlobWithFolder, folder_path.DirName(), mime_boundary,
-                     std::move(files));
-
-  std::string content_type = ipfs::kIPFSImportMultipartContentType;
-  content_type += " boundary=";
-  content_type += mime_boundary;
+    const std::string& content_type,
+    std::unique_ptr<storage::BlobDataBuilder> blob_builder) {
+  auto blob_builder_callback = base::BindOnce(
+      [](std::unique_ptr<storage::BlobDataBuilder> blob_builder) {
+        return blob_builder;
+      },
+      std::move(blob_builder));
 
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock(), content::BrowserThread::IO},
@@ -310,11 +293,16 @@ void CreateRequestForFileList(
 void CreateRequestForFolder(const base::FilePath& folder_path,
                             ipfs::BlobContextGetterFactory* context_factory,
                             ResourceRequestGetter request_callback) {
+  std::string mime_boundary = net::GenerateMimeMultipartBoundary();
+  std::string content_type = ipfs::kIPFSImportMultipartContentType;
+  content_type += " boundary=";
+  content_type += mime_boundary;
+
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&EnumerateDirectoryFiles, folder_path),
-      base::BindOnce(&CreateRequestForFileList, std::move(request_callback),
-                     context_factory, folder_path));
+      base::BindOnce(&BuildBlobWithFolder, folder_path, mime_boundary),
+      base::BindOnce(&CreateRequestForFolderBlob, std::move(request_callback),
+                     context_factory, content_type));
 }
 
 void CreateRequestForText(const std::string& text,
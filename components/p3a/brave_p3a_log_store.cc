@@ -5,6 +5,8 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include <algorithm>
+
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/rand_util.h"
@@ -34,6 +36,11 @@ void RecordP3A(uint64_t answers_count) {
   UMA_HISTOGRAM_EXACT_LINEAR("Brave.P3A.SentAnswersCount", answer, 3);
 }
 
+bool IsP2AMetric(base::StringPiece histogram_name) {
+  return base::StartsWith(histogram_name, "Brave.P2A",
+                          base::CompareCase::SENSITIVE);
+}
+
 }  // namespace
 
 BraveP3ALogStore::BraveP3ALogStore(Delegate* delegate,
@@ -74,9 +81,12 @@ void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
   DictionaryPrefUpdate update(local_state_, kPrefName);
   update->RemovePath(histogram_name);
 
-  if (has_staged_log() && staged_entry_key_ == histogram_name) {
-    staged_entry_key_.clear();
-    staged_log_.clear();
+  auto staged_iter = std::find(staged_entry_keys_.begin(),
+                               staged_entry_keys_.end(), histogram_name);
+  if (staged_iter != staged_entry_keys_.end()) {
+    staged_logs_.erase(staged_logs_.begin() +
+                       (staged_iter - staged_entry_keys_.begin()));
+    staged_entry_keys_.erase(staged_iter);
   }
 }
 
@@ -111,24 +121,20 @@ bool BraveP3ALogStore::has_unsent_logs() const {
 }
 
 bool BraveP3ALogStore::has_staged_log() const {
-  return !staged_entry_key_.empty();
+  return !staged_entry_keys_.empty();
 }
 
 const std::string& BraveP3ALogStore::staged_log() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
+  DCHECK_EQ(staged_entry_keys_.size(), 1u);
+  DCHECK(log_.find(staged_entry_keys_.front()) != log_.end());
 
-  return staged_log_;
+  return staged_logs_.front();
 }
 
 std::string BraveP3ALogStore::staged_log_type() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
-
-  if (base::StartsWith(iter->first, "Brave.P2A",
-                       base::CompareCase::SENSITIVE)) {
+  DCHECK(has_staged_log());
+  // All staged entries share the same type, see |StageNextLogs()|.
+  if (IsP2AMetric(staged_entry_keys_.front())) {
     return "p2a";
   }
   return "p3a";
@@ -150,16 +156,40 @@ absl::optional<uint64_t> BraveP3ALogStore::staged_log_user_id() const {
 }
 
 void BraveP3ALogStore::StageNextLog() {
-  // Stage the next item.
+  StageNextLogs(1);
+}
+
+void BraveP3ALogStore::StageNextLogs(size_t max_count) {
+  // Stage the next items.
   DCHECK(has_unsent_logs());
-  uint64_t rand_idx = base::RandGenerator(unsent_entries_.size());
-  staged_entry_key_ = *(unsent_entries_.begin() + rand_idx);
-  DCHECK(!log_.find(staged_entry_key_)->second.sent);
+  DCHECK_GT(max_count, 0u);
+  staged_entry_keys_.clear();
+  staged_logs_.clear();
 
-  uint64_t staged_entry_value = log_[staged_entry_key_].value;
-  staged_log_ = delegate_->Serialize(staged_entry_key_, staged_entry_value);
+  uint64_t rand_idx = base::RandGenerator(unsent_entries_.size());
+  const std::string& first_key = *(unsent_entries_.begin() + rand_idx);
+  staged_entry_keys_.push_back(first_key);
+
+  // Fill the rest of the batch with random values going to the same endpoint.
+  if (max_count > 1) {
+    const bool is_p2a = IsP2AMetric(first_key);
+    std::vector<std::string> candidates;
+    for (const std::string& key : unsent_entries_) {
+      if (key != first_key && IsP2AMetric(key) == is_p2a) {
+        candidates.push_back(key);
+      }
+    }
+    base::RandomShuffle(candidates.begin(), candidates.end());
+    candidates.resize(std::min(candidates.size(), max_count - 1));
+    staged_entry_keys_.insert(staged_entry_keys_.end(), candidates.begin(),
+                              candidates.end());
+  }
 
-  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << staged_entry_key_;
+  for (const std::string& key : staged_entry_keys_) {
+    DCHECK(!log_.find(key)->second.sent);
+    staged_logs_.push_back(delegate_->Serialize(key, log_[key].value));
+    VLOG(2) << "BraveP3ALogStore::StageNextLogs: staged " << key;
+  }
 }
 
 void BraveP3ALogStore::DiscardStagedLog() {
@@ -167,25 +197,27 @@ void BraveP3ALogStore::DiscardStagedLog() {
     return;
   }
 
-  // Mark previous staged log as sent.
-  auto log_iter = log_.find(staged_entry_key_);
-  DCHECK(log_iter != log_.end());
-  log_iter->second.MarkAsSent();
-
-  // Update the persistent value.
   DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({log_iter->first, kLogSentKey},
-                  base::Value(log_iter->second.sent));
-  update->SetPath({log_iter->first, kLogTimestampKey},
-                  base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
-
-  // Erase the entry from the unsent queue.
-  auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
-  DCHECK(unsent_entries_iter != unsent_entries_.end());
-  unsent_entries_.erase(unsent_entries_iter);
-
-  staged_entry_key_.clear();
-  staged_log_.clear();
+  for (const std::string& key : staged_entry_keys_) {
+    // Mark previous staged log as sent.
+    auto log_iter = log_.find(key);
+    DCHECK(log_iter != log_.end());
+    log_iter->second.MarkAsSent();
+
+    // Update the persistent value.
+    update->SetPath({log_iter->first, kLogSentKey},
+                    base::Value(log_iter->second.sent));
+    update->SetPath({log_iter->first, kLogTimestampKey},
+                    base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
+
+    // Erase the entry from the unsent queue.
+    auto unsent_entries_iter = unsent_entries_.find(key);
+    DCHECK(unsent_entries_iter != unsent_entries_.end());
+    unsent_entries_.erase(unsent_entries_iter);
+  }
+
+  staged_entry_keys_.clear();
+  staged_logs_.clear();
 }
 
 void BraveP3ALogStore::MarkStagedLogAsSent() {}
@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_STORE_H_
 
 #include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
@@ -50,6 +51,15 @@ class BraveP3ALogStore : public metrics::LogStore {
   // Marks all saved values as unsent.
   void ResetUploadStamps();
 
+  size_t unsent_logs_count() const { return unsent_entries_.size(); }
+
+  // Stages up to |max_count| unsent values of the same type (p3a or p2a) to be
+  // uploaded together. Each value is serialized independently and is marked as
+  // sent on its own by |DiscardStagedLog()|, so removing a value while a batch
+  // is in flight only drops that value.
+  void StageNextLogs(size_t max_count);
+  const std::vector<std::string>& staged_logs() const { return staged_logs_; }
+
   // metrics::LogStore:
   bool has_unsent_logs() const override;
   bool has_staged_log() const override;
@@ -93,8 +103,10 @@ class BraveP3ALogStore : public metrics::LogStore {
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
 
-  std::string staged_entry_key_;
-  std::string staged_log_;
+  // Parallel vectors: |staged_logs_[i]| is the serialized value of
+  // |staged_entry_keys_[i]|.
+  std::vector<std::string> staged_entry_keys_;
+  std::vector<std::string> staged_logs_;
 
   // Not used for now.
   std::string staged_log_hash_;
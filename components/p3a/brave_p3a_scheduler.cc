@@ -5,6 +5,8 @@
 
 #include "brave/components/p3a/brave_p3a_scheduler.h"
 
+#include <algorithm>
+
 #include "base/rand_util.h"
 
 namespace brave {
@@ -45,14 +47,16 @@ base::TimeDelta BackOffUploadInterval(base::TimeDelta interval) {
 
 BraveP3AScheduler::BraveP3AScheduler(
     const base::RepeatingClosure& upload_callback,
-    const base::RepeatingCallback<base::TimeDelta(void)>& get_interval_callback)
+    const base::RepeatingCallback<base::TimeDelta(void)>& get_interval_callback,
+    size_t max_batch_size)
     : metrics::MetricsScheduler(upload_callback,
                                 false /* fast_startup_for_testing */),
       get_interval_callback_(get_interval_callback),
       initial_backoff_interval_(
           base::TimeDelta::FromSeconds(kInitialBackoffIntervalSeconds)),
       backoff_interval_(
-          base::TimeDelta::FromSeconds(kInitialBackoffIntervalSeconds)) {}
+          base::TimeDelta::FromSeconds(kInitialBackoffIntervalSeconds)),
+      max_batch_size_(std::max<size_t>(max_batch_size, 1)) {}
 
 BraveP3AScheduler::~BraveP3AScheduler() {}
 
@@ -66,4 +70,15 @@ void BraveP3AScheduler::UploadFinished(bool ok) {
   }
 }
 
+size_t BraveP3AScheduler::GetBatchSize(size_t pending_count) const {
+  // Spread the pending values over as few uploads as the batch limit allows,
+  // keeping batches roughly equal so the last one isn't a lone straggler.
+  if (pending_count <= max_batch_size_) {
+    return std::max<size_t>(pending_count, 1);
+  }
+  const size_t uploads_needed =
+      (pending_count + max_batch_size_ - 1) / max_batch_size_;
+  return (pending_count + uploads_needed - 1) / uploads_needed;
+}
+
 }  // namespace brave
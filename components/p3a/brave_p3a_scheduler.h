@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_P3A_BRAVE_P3A_SCHEDULER_H_
 #define BRAVE_COMPONENTS_P3A_BRAVE_P3A_SCHEDULER_H_
 
+#include <stddef.h>
+
 #include "base/callback_forward.h"
 #include "components/metrics/metrics_scheduler.h"
 
@@ -16,11 +18,16 @@ class BraveP3AScheduler : public metrics::MetricsScheduler {
   explicit BraveP3AScheduler(
       const base::RepeatingClosure& upload_callback,
       const base::RepeatingCallback<base::TimeDelta(void)>&
-          get_interval_callback);
+          get_interval_callback,
+      size_t max_batch_size = 1);
   ~BraveP3AScheduler() override;
 
   void UploadFinished(bool ok);
 
+  // Returns how many of |pending_count| unsent values should go into the next
+  // upload.
+  size_t GetBatchSize(size_t pending_count) const;
+
  private:
   // Provides us with the interval between successful uploads.
   base::RepeatingCallback<base::TimeDelta(void)> get_interval_callback_;
@@ -31,6 +38,9 @@ class BraveP3AScheduler : public metrics::MetricsScheduler {
   // Time to wait for the next upload attempt if the next one fails.
   base::TimeDelta backoff_interval_;
 
+  // Upper bound for |GetBatchSize()|, 1 unless batched uploads are enabled.
+  const size_t max_batch_size_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveP3AScheduler);
 };
 
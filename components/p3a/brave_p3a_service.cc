@@ -241,6 +241,7 @@ void BraveP3AService::Init(
   VLOG(2) << "BraveP3AService parameters are:"
           << ", average_upload_interval_ = " << average_upload_interval_
           << ", randomize_upload_interval_ = " << randomize_upload_interval_
+          << ", max_upload_batch_size_ = " << max_upload_batch_size_
           << ", upload_server_url_ = " << upload_server_url_.spec()
           << ", rotation_interval_ = " << rotation_interval_;
 
@@ -279,7 +280,8 @@ void BraveP3AService::Init(
            ? base::BindRepeating(GetRandomizedUploadInterval,
                                  average_upload_interval_)
            : base::BindRepeating([](base::TimeDelta x) { return x; },
-                                 average_upload_interval_))));
+                                 average_upload_interval_)),
+      max_upload_batch_size_));
 
   upload_scheduler_->Start();
   if (!rotation_timer_.IsRunning()) {
@@ -332,6 +334,15 @@ void BraveP3AService::MaybeOverrideSettingsFromCommandLine() {
     randomize_upload_interval_ = false;
   }
 
+  if (cmdline->HasSwitch(switches::kP3AUploadBatchSize)) {
+    std::string batch_size_str =
+        cmdline->GetSwitchValueASCII(switches::kP3AUploadBatchSize);
+    size_t batch_size;
+    if (base::StringToSizeT(batch_size_str, &batch_size) && batch_size > 0) {
+      max_upload_batch_size_ = batch_size;
+    }
+  }
+
   if (cmdline->HasSwitch(switches::kP3ARotationIntervalSeconds)) {
     std::string seconds_str =
         cmdline->GetSwitchValueASCII(switches::kP3ARotationIntervalSeconds);
@@ -392,18 +403,27 @@ void BraveP3AService::StartScheduledUpload() {
     VLOG(2) << "StartScheduledUpload - Nothing to stage.";
     return;
   }
+  // A batch staged earlier is retried as is after a failed upload.
   if (!log_store_->has_staged_log()) {
-    log_store_->StageNextLog();
+    log_store_->StageNextLogs(
+        upload_scheduler_->GetBatchSize(log_store_->unsent_logs_count()));
   }
 
   // Only upload if service is enabled.
   bool p3a_enabled = local_state_->GetBoolean(brave::kP3AEnabled);
   if (p3a_enabled) {
-    const std::string log = log_store_->staged_log();
     const std::string log_type = log_store_->staged_log_type();
-    VLOG(2) << "StartScheduledUpload - Uploading " << log.size() << " bytes "
-            << "of type " << log_type;
-    uploader_->UploadLog(log, log_type);
+    if (log_store_->staged_logs().size() == 1) {
+      const std::string log = log_store_->staged_log();
+      VLOG(2) << "StartScheduledUpload - Uploading " << log.size() << " bytes "
+              << "of type " << log_type;
+      uploader_->UploadLog(log, log_type);
+    } else {
+      const std::vector<std::string> logs = log_store_->staged_logs();
+      VLOG(2) << "StartScheduledUpload - Uploading " << logs.size()
+              << " values of type " << log_type;
+      uploader_->UploadLogs(logs, log_type);
+    }
   }
 }
 
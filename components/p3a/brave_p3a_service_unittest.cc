@@ -0,0 +1,197 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_service.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback_helpers.h"
+#include "base/json/json_reader.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/bind.h"
+#include "base/test/scoped_command_line.h"
+#include "brave/components/brave_referrals/common/pref_names.h"
+#include "brave/components/p3a/brave_p3a_scheduler.h"
+#include "brave/components/p3a/brave_p3a_switches.h"
+#include "components/prefs/testing_pref_service.h"
+#include "content/public/test/browser_task_environment.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "services/network/test/test_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=P3AServiceTest.*
+
+namespace brave {
+
+namespace {
+
+constexpr char kP3AServerUrl[] = "https://p3a.brave.com/";
+
+// Collected metrics recorded by the tests. The service also reports
+// "Brave.P3A.SentAnswersCount" on its first rotation, so one more value than
+// listed here is pending after initialization.
+constexpr const char* kTestHistograms[] = {
+    "Brave.Core.IsDefault",
+    "Brave.Core.TabCount",
+    "Brave.Core.WindowCount.2",
+    "Brave.NTP.NewTabsCreated",
+};
+constexpr size_t kPendingValueCount = base::size(kTestHistograms) + 1;
+
+}  // namespace
+
+class P3AServiceTest : public testing::Test {
+ public:
+  P3AServiceTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)) {}
+
+  void SetUp() override {
+    statistics_recorder_ =
+        base::StatisticsRecorder::CreateTemporaryForTesting();
+
+    BraveP3AService::RegisterPrefs(local_state_.registry(), true);
+    local_state_.registry()->RegisterStringPref(kReferralPromoCode,
+                                                std::string());
+
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [&](const network::ResourceRequest& request) {
+          upload_bodies_.push_back(network::GetUploadData(request));
+          upload_content_types_.push_back(
+              request.headers.GetHeader("Content-Type").value_or(""));
+          url_loader_factory_.AddResponse(request.url.spec(), std::string(),
+                                          response_status_);
+        }));
+  }
+
+  void TearDown() override { service_.reset(); }
+
+ protected:
+  void StartService(size_t batch_size) {
+    base::CommandLine* cmdline = scoped_command_line_.GetProcessCommandLine();
+    cmdline->AppendSwitchASCII(switches::kP3AUploadIntervalSeconds, "10");
+    cmdline->AppendSwitch(switches::kP3ADoNotRandomizeUploadInterval);
+    cmdline->AppendSwitchASCII(switches::kP3ARotationIntervalSeconds,
+                               base::NumberToString(60 * 60 * 24));
+    cmdline->AppendSwitchASCII(switches::kP3AUploadServerUrl, kP3AServerUrl);
+    cmdline->AppendSwitchASCII(switches::kP3AUploadBatchSize,
+                               base::NumberToString(batch_size));
+
+    service_ = base::MakeRefCounted<BraveP3AService>(&local_state_, "release",
+                                                     "2021-01-04");
+    service_->InitCallbacks();
+    service_->Init(shared_url_loader_factory_);
+
+    for (const char* histogram_name : kTestHistograms) {
+      base::UmaHistogramExactLinear(histogram_name, 1, 3);
+    }
+    task_environment_.RunUntilIdle();
+  }
+
+  // Advances time until |count| uploads have been made, giving up after an
+  // hour of mock time.
+  void WaitForUploads(size_t count) {
+    for (int i = 0; i < 60 * 60 && upload_bodies_.size() < count; ++i) {
+      task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+    }
+  }
+
+  content::BrowserTaskEnvironment task_environment_;
+  base::test::ScopedCommandLine scoped_command_line_;
+  std::unique_ptr<base::StatisticsRecorder> statistics_recorder_;
+  TestingPrefServiceSimple local_state_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  scoped_refptr<BraveP3AService> service_;
+
+  net::HttpStatusCode response_status_ = net::HTTP_OK;
+  std::vector<std::string> upload_bodies_;
+  std::vector<std::string> upload_content_types_;
+};
+
+TEST_F(P3AServiceTest, UploadsOneValuePerRequestByDefault) {
+  StartService(1);
+  WaitForUploads(kPendingValueCount);
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(10));
+
+  EXPECT_EQ(kPendingValueCount, upload_bodies_.size());
+  for (const std::string& content_type : upload_content_types_) {
+    EXPECT_EQ("application/base64", content_type);
+  }
+}
+
+TEST_F(P3AServiceTest, BatchesPendingValues) {
+  StartService(10);
+  WaitForUploads(1);
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(10));
+
+  ASSERT_EQ(1u, upload_bodies_.size());
+  EXPECT_EQ("application/json", upload_content_types_[0]);
+  absl::optional<base::Value> batch = base::JSONReader::Read(upload_bodies_[0]);
+  ASSERT_TRUE(batch && batch->is_list());
+  EXPECT_EQ(kPendingValueCount, batch->GetList().size());
+}
+
+TEST_F(P3AServiceTest, SplitsPendingValuesIntoBatches) {
+  StartService(2);
+  WaitForUploads(kPendingValueCount);
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(10));
+
+  // Five pending values with a limit of two per upload take three uploads.
+  ASSERT_EQ(3u, upload_bodies_.size());
+  size_t uploaded_values = 0;
+  for (const std::string& body : upload_bodies_) {
+    absl::optional<base::Value> batch = base::JSONReader::Read(body);
+    if (batch && batch->is_list()) {
+      uploaded_values += batch->GetList().size();
+    } else {
+      ++uploaded_values;
+    }
+  }
+  EXPECT_EQ(kPendingValueCount, uploaded_values);
+}
+
+TEST_F(P3AServiceTest, FailedBatchIsRetried) {
+  response_status_ = net::HTTP_INTERNAL_SERVER_ERROR;
+  StartService(10);
+  WaitForUploads(1);
+  ASSERT_EQ(1u, upload_bodies_.size());
+
+  // The whole batch stays staged and is sent again once the server recovers.
+  response_status_ = net::HTTP_OK;
+  WaitForUploads(2);
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(10));
+
+  ASSERT_EQ(2u, upload_bodies_.size());
+  EXPECT_EQ(upload_bodies_[0], upload_bodies_[1]);
+}
+
+TEST(P3ASchedulerTest, GetBatchSize) {
+  BraveP3AScheduler unbatched(base::DoNothing(), base::BindRepeating([]() {
+                                return base::TimeDelta::FromSeconds(1);
+                              }));
+  EXPECT_EQ(1u, unbatched.GetBatchSize(0));
+  EXPECT_EQ(1u, unbatched.GetBatchSize(25));
+
+  BraveP3AScheduler batched(base::DoNothing(), base::BindRepeating([]() {
+                              return base::TimeDelta::FromSeconds(1);
+                            }),
+                            10);
+  EXPECT_EQ(1u, batched.GetBatchSize(1));
+  EXPECT_EQ(10u, batched.GetBatchSize(10));
+  // 25 values take three uploads, sized as evenly as possible.
+  EXPECT_EQ(9u, batched.GetBatchSize(25));
+}
+
+}  // namespace brave
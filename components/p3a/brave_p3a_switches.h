@@ -22,6 +22,10 @@ constexpr char kP3ARotationIntervalSeconds[] = "p3a-rotation-interval-seconds";
 // P3A cloud backend URL.
 constexpr char kP3AUploadServerUrl[] = "p3a-upload-server-url";
 
+// Maximum number of values packed into a single upload. Values above 1 enable
+// batched uploads.
+constexpr char kP3AUploadBatchSize[] = "p3a-upload-batch-size";
+
 // Do not try to resent values even if a cloud returned an HTTP error, just
 // continue the normal process.
 constexpr char kP3AIgnoreServerErrors[] = "p3a-ignore-server-errors";
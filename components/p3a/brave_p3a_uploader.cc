@@ -8,6 +8,8 @@
 #include <utility>
 
 #include "base/base64.h"
+#include "base/json/json_writer.h"
+#include "base/values.h"
 #include "net/base/load_flags.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
@@ -82,6 +84,28 @@ BraveP3AUploader::~BraveP3AUploader() = default;
 
 void BraveP3AUploader::UploadLog(const std::string& compressed_log_data,
                                  const std::string& upload_type) {
+  std::string base64;
+  base::Base64Encode(compressed_log_data, &base64);
+  SendRequest(base64, "application/base64", upload_type);
+}
+
+void BraveP3AUploader::UploadLogs(const std::vector<std::string>& logs,
+                                  const std::string& upload_type) {
+  DCHECK(!logs.empty());
+  base::Value list(base::Value::Type::LIST);
+  for (const std::string& log : logs) {
+    std::string base64;
+    base::Base64Encode(log, &base64);
+    list.Append(std::move(base64));
+  }
+  std::string json;
+  base::JSONWriter::Write(list, &json);
+  SendRequest(json, "application/json", upload_type);
+}
+
+void BraveP3AUploader::SendRequest(const std::string& upload_data,
+                                   const std::string& upload_content_type,
+                                   const std::string& upload_type) {
   auto resource_request = std::make_unique<network::ResourceRequest>();
   if (upload_type == "p2a") {
     resource_request->url = p2a_endpoint_;
@@ -99,9 +123,7 @@ void BraveP3AUploader::UploadLog(const std::string& compressed_log_data,
   url_loader_ = network::SimpleURLLoader::Create(
       std::move(resource_request),
       GetNetworkTrafficAnnotation(upload_type));
-  std::string base64;
-  base::Base64Encode(compressed_log_data, &base64);
-  url_loader_->AttachStringForUpload(base64, "application/base64");
+  url_loader_->AttachStringForUpload(upload_data, upload_content_type);
 
   url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
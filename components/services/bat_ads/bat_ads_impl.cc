@@ -127,6 +127,14 @@ void BatAdsImpl::OnTabClosed(
   ads_->OnTabClosed(tab_id);
 }
 
+void BatAdsImpl::OnBrowsingHistoryVisited(const std::string& url) {
+  ads_->OnBrowsingHistoryVisited(url);
+}
+
+void BatAdsImpl::OnBrowsingHistoryDeleted() {
+  ads_->OnBrowsingHistoryDeleted();
+}
+
 void BatAdsImpl::GetAdNotification(
     const std::string& uuid,
     GetAdNotificationCallback callback) {
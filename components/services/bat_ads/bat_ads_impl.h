@@ -79,6 +79,9 @@ class BatAdsImpl :
   void OnTabClosed(
       const int32_t tab_id) override;
 
+  void OnBrowsingHistoryVisited(const std::string& url) override;
+  void OnBrowsingHistoryDeleted() override;
+
   void GetAdNotification(
       const std::string& uuid,
       GetAdNotificationCallback callback) override;
@@ -4,7 +4,7 @@
 
 import '../../../../brave_extension/extension/brave_extension/background/events/shieldsEvents'
 import actions from '../../../../brave_extension/extension/brave_extension/background/actions/shieldsPanelActions'
-import { blockedResource } from '../../../testData'
+import { blockedResource, blockedResources } from '../../../testData'
 
 describe('shieldsEvents events', () => {
   describe('chrome.braveShields.onBlocked listener', () => {
@@ -15,13 +15,24 @@ describe('shieldsEvents events', () => {
     afterEach(() => {
       spy.mockRestore()
     })
-    it('forward details to actions.resourceBlocked', (cb) => {
+    it('forwards each blocked resource to actions.resourceBlocked in order', (cb) => {
       chrome.braveShields.onBlocked.addListener((details) => {
-        expect(details).toBe(blockedResource)
-        expect(spy).toBeCalledWith(details)
+        expect(details).toBe(blockedResources)
+        expect(spy).toHaveBeenCalledTimes(3)
+        expect(spy).toHaveBeenNthCalledWith(1, blockedResource)
+        expect(spy).toHaveBeenNthCalledWith(2, {
+          tabId: 2,
+          blockType: 'shieldsAds',
+          subresource: 'https://www.brave.com/test2'
+        })
+        expect(spy).toHaveBeenNthCalledWith(3, {
+          tabId: 2,
+          blockType: 'javascript',
+          subresource: 'https://www.brave.com/test.js'
+        })
         cb()
       })
-      chrome.braveShields.onBlocked.emit(blockedResource)
+      chrome.braveShields.onBlocked.emit(blockedResources)
     })
   })
 })
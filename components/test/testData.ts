@@ -102,6 +102,20 @@ export const blockedResource: BlockDetails = {
   subresource: 'https://www.brave.com/test'
 }
 
+export const blockedResources: BlockedResourcesDetails = {
+  tabId: 2,
+  blocked: [
+    {
+      blockType: 'shieldsAds',
+      subresources: ['https://www.brave.com/test', 'https://www.brave.com/test2']
+    },
+    {
+      blockType: 'javascript',
+      subresources: ['https://www.brave.com/test.js']
+    }
+  ]
+}
+
 // see: https://developer.chrome.com/extensions/events
 interface OnMessageEvent extends chrome.events.Event<(message: object, options: any, responseCallback: any) => void> {
   emit: (message: object) => void
@@ -1910,16 +1910,6 @@ BATLedgerBridge(BOOL,
             }];
 }
 
-- (std::string)URIEncode:(const std::string&)value {
-  const auto allowedCharacters =
-      [NSMutableCharacterSet alphanumericCharacterSet];
-  [allowedCharacters addCharactersInString:@"-._~"];
-  const auto string = base::SysUTF8ToNSString(value);
-  const auto encoded = [string
-      stringByAddingPercentEncodingWithAllowedCharacters:allowedCharacters];
-  return base::SysNSStringToUTF8(encoded);
-}
-
 - (void)fetchFavIcon:(const std::string&)url
           faviconKey:(const std::string&)favicon_key
             callback:(ledger::client::FetchIconCallback)callback {
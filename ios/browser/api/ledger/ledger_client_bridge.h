@@ -31,7 +31,6 @@
 - (void)onReconcileComplete:(ledger::type::Result)result
                contribution:(ledger::type::ContributionInfoPtr)contribution;
 - (void)publisherListNormalized:(ledger::type::PublisherInfoList)list;
-- (std::string)URIEncode:(const std::string&)value;
 - (void)onContributeUnverifiedPublishers:(ledger::type::Result)result
                             publisherKey:(const std::string&)publisher_key
                            publisherName:(const std::string&)publisher_name;
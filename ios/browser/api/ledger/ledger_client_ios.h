@@ -39,7 +39,6 @@ class LedgerClientIOS : public ledger::LedgerClient {
       ledger::type::Result result,
       ledger::type::ContributionInfoPtr contribution) override;
   void PublisherListNormalized(ledger::type::PublisherInfoList list) override;
-  std::string URIEncode(const std::string& value) override;
   void OnContributeUnverifiedPublishers(
       ledger::type::Result result,
       const std::string& publisher_key,
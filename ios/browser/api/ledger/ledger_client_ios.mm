@@ -56,9 +56,6 @@ void LedgerClientIOS::PublisherListNormalized(
     ledger::type::PublisherInfoList list) {
   [bridge_ publisherListNormalized:std::move(list)];
 }
-std::string LedgerClientIOS::URIEncode(const std::string& value) {
-  return [bridge_ URIEncode:value];
-}
 void LedgerClientIOS::OnContributeUnverifiedPublishers(
     ledger::type::Result result,
     const std::string& publisher_key,
@@ -40,7 +40,6 @@ void BraveWalletRenderFrameObserver::DidCreateScriptContext(
     return;
 
   native_javascript_handle_->AddJavaScriptObjectToFrame(context);
-  native_javascript_handle_->ConnectEvent();
 }
 
 void BraveWalletRenderFrameObserver::OnDestruct() {
@@ -18,6 +18,13 @@ BraveExternalProcessImporterBridge::BraveExternalProcessImporterBridge(
 BraveExternalProcessImporterBridge::
     ~BraveExternalProcessImporterBridge() = default;
 
+void BraveExternalProcessImporterBridge::SetHistoryItems(
+    const std::vector<ImporterURLRow>& rows,
+    importer::VisitSource visit_source) {
+  // Blocks the import thread until the browser has taken the batch.
+  brave_observer_->OnHistoryImportBatchReady(rows, visit_source);
+}
+
 void BraveExternalProcessImporterBridge::SetCreditCard(
     const std::u16string& name_on_card,
     const std::u16string& expiration_month,
@@ -7,9 +7,11 @@
 #define BRAVE_UTILITY_IMPORTER_BRAVE_EXTERNAL_PROCESS_IMPORTER_BRIDGE_H_
 
 #include <string>
+#include <vector>
 
 #include "brave/common/importer/brave_importer_bridge.h"
 #include "brave/common/importer/profile_import.mojom.h"
+#include "chrome/common/importer/importer_url_row.h"
 #include "chrome/utility/importer/external_process_importer_bridge.h"
 
 class BraveExternalProcessImporterBridge : public ExternalProcessImporterBridge,
@@ -25,6 +27,11 @@ class BraveExternalProcessImporterBridge : public ExternalProcessImporterBridge,
   BraveExternalProcessImporterBridge& operator=(
       const BraveExternalProcessImporterBridge&) = delete;
 
+  // ExternalProcessImporterBridge overrides:
+  void SetHistoryItems(const std::vector<ImporterURLRow>& rows,
+                       importer::VisitSource visit_source) override;
+
+  // BraveImporterBridge overrides:
   void SetCreditCard(const std::u16string& name_on_card,
                      const std::u16string& expiration_month,
                      const std::u16string& expiration_year,
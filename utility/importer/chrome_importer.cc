@@ -17,6 +17,7 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/values.h"
 #include "brave/common/importer/scoped_copy_file.h"
+#include "brave/common/importer/source_profile_database.h"
 #include "brave/utility/importer/brave_external_process_importer_bridge.h"
 #include "build/build_config.h"
 #include "chrome/common/importer/imported_bookmark_entry.h"
@@ -220,25 +221,22 @@ void ChromeImporter::StartImport(const importer::SourceProfile& source_profile,
 void ChromeImporter::ImportHistory() {
   base::FilePath history_path = source_path_.Append(
       base::FilePath::StringType(FILE_PATH_LITERAL("History")));
-  if (!base::PathExists(history_path))
+  SourceProfileDatabase history_db;
+  if (!history_db.Open(history_path))
     return;
+  sql::Database& db = *history_db.db();
 
-  ScopedCopyFile copy_history_file(history_path);
-  if (!copy_history_file.copy_success())
-    return;
-
-  sql::Database db;
-  if (!db.Open(copy_history_file.copied_file_path())) {
-    return;
-  }
-
+  // Visits are grouped per url so every url is sent once, with its most
+  // recent qualifying visit. Rows are read in url id order, which lets SQLite
+  // stream them without materializing the whole result.
   const char query[] =
-      "SELECT u.url, u.title, v.visit_time, u.typed_count, u.visit_count "
+      "SELECT u.url, u.title, MAX(v.visit_time), u.typed_count, u.visit_count "
       "FROM urls u JOIN visits v ON u.id = v.url "
       "WHERE hidden = 0 "
-      "AND (transition & ?) != 0 "              // CHAIN_END
-      "AND (transition & ?) NOT IN (?, ?, ?)";  // No SUBFRAME or
-                                                // KEYWORD_GENERATED
+      "AND (transition & ?) != 0 "               // CHAIN_END
+      "AND (transition & ?) NOT IN (?, ?, ?) "   // No SUBFRAME or
+                                                 // KEYWORD_GENERATED
+      "GROUP BY u.id ORDER BY u.id";
 
   sql::Statement s(db.GetUniqueStatement(query));
   s.BindInt64(0, ui::PAGE_TRANSITION_CHAIN_END);
@@ -248,6 +246,7 @@ void ChromeImporter::ImportHistory() {
   s.BindInt64(4, ui::PAGE_TRANSITION_KEYWORD_GENERATED);
 
   std::vector<ImporterURLRow> rows;
+  rows.reserve(kHistoryBatchSize);
   while (s.Step() && !cancelled()) {
     GURL url(s.ColumnString(0));
 
@@ -259,7 +258,11 @@ void ChromeImporter::ImportHistory() {
     row.typed_count = s.ColumnInt(3);
     row.visit_count = s.ColumnInt(4);
 
-    rows.push_back(row);
+    rows.push_back(std::move(row));
+    if (rows.size() == kHistoryBatchSize) {
+      bridge_->SetHistoryItems(rows, importer::VISIT_SOURCE_CHROME_IMPORTED);
+      rows.clear();
+    }
   }
 
   if (!rows.empty() && !cancelled())
@@ -270,12 +273,10 @@ void ChromeImporter::ImportBookmarks() {
   std::string bookmarks_content;
   base::FilePath bookmarks_path = source_path_.Append(
       base::FilePath::StringType(FILE_PATH_LITERAL("Bookmarks")));
-  ScopedCopyFile copy_bookmark_file(bookmarks_path);
-  if (!copy_bookmark_file.copy_success())
+  // Chrome replaces Bookmarks atomically on write, so it is read directly.
+  if (!base::ReadFileToString(bookmarks_path, &bookmarks_content))
     return;
 
-  base::ReadFileToString(copy_bookmark_file.copied_file_path(),
-                         &bookmarks_content);
   absl::optional<base::Value> bookmarks_json =
       base::JSONReader::Read(bookmarks_content);
   const base::DictionaryValue* bookmark_dict;
@@ -313,25 +314,15 @@ void ChromeImporter::ImportBookmarks() {
   // Import favicons.
   base::FilePath favicons_path = source_path_.Append(
       base::FilePath::StringType(FILE_PATH_LITERAL("Favicons")));
-  if (!base::PathExists(favicons_path))
-    return;
-
-  ScopedCopyFile copy_favicon_file(favicons_path);
-  if (!copy_favicon_file.copy_success())
-    return;
-
-  sql::Database db;
-  if (!db.Open(copy_favicon_file.copied_file_path()))
+  SourceProfileDatabase favicons_db;
+  if (!favicons_db.Open(favicons_path))
     return;
 
   FaviconMap favicon_map;
-  ImportFaviconURLs(&db, &favicon_map);
+  ImportFaviconURLs(favicons_db.db(), &favicon_map);
   // Write favicons into profile.
-  if (!favicon_map.empty() && !cancelled()) {
-    favicon_base::FaviconUsageDataList favicons;
-    LoadFaviconData(&db, favicon_map, &favicons);
-    bridge_->SetFavicons(favicons);
-  }
+  if (!favicon_map.empty() && !cancelled())
+    LoadFaviconData(favicons_db.db(), favicon_map);
 }
 
 void ChromeImporter::ImportFaviconURLs(sql::Database* db,
@@ -346,10 +337,8 @@ void ChromeImporter::ImportFaviconURLs(sql::Database* db,
   }
 }
 
-void ChromeImporter::LoadFaviconData(
-    sql::Database* db,
-    const FaviconMap& favicon_map,
-    favicon_base::FaviconUsageDataList* favicons) {
+void ChromeImporter::LoadFaviconData(sql::Database* db,
+                                     const FaviconMap& favicon_map) {
   const char query[] =
       "SELECT f.url, fb.image_data "
       "FROM favicons f "
@@ -361,8 +350,9 @@ void ChromeImporter::LoadFaviconData(
   if (!s.is_valid())
     return;
 
+  favicon_base::FaviconUsageDataList favicons;
   for (FaviconMap::const_iterator i = favicon_map.begin();
-       i != favicon_map.end(); ++i) {
+       i != favicon_map.end() && !cancelled(); ++i) {
     s.BindInt64(0, i->first);
     if (s.Step()) {
       favicon_base::FaviconUsageData usage;
@@ -380,10 +370,17 @@ void ChromeImporter::LoadFaviconData(
         continue;  // Unable to decode.
 
       usage.urls = i->second;
-      favicons->push_back(usage);
+      favicons.push_back(std::move(usage));
+      if (favicons.size() == kFaviconBatchSize) {
+        bridge_->SetFavicons(favicons);
+        favicons.clear();
+      }
     }
     s.Reset(true);
   }
+
+  if (!favicons.empty() && !cancelled())
+    bridge_->SetFavicons(favicons);
 }
 
 void ChromeImporter::RecursiveReadBookmarksFolder(
@@ -448,6 +445,8 @@ void ChromeImporter::ImportPasswords() {
   if (!base::PathExists(passwords_path))
     return;
 
+  // LoginDatabase::Init() may migrate the schema, so the file is always
+  // copied rather than opened in place.
   ScopedCopyFile copy_password_file(passwords_path);
   if (!copy_password_file.copy_success())
     return;
@@ -483,17 +482,10 @@ void ChromeImporter::ImportPasswords() {
 void ChromeImporter::ImportPayments() {
   const base::FilePath payments_path = source_path_.Append(kWebDataFilename);
 
-  if (!base::PathExists(payments_path))
+  SourceProfileDatabase payments_db;
+  if (!payments_db.Open(payments_path))
     return;
-
-  ScopedCopyFile copy_payments_file(payments_path);
-  if (!copy_payments_file.copy_success())
-    return;
-
-  sql::Database db;
-  if (!db.Open(copy_payments_file.copied_file_path())) {
-    return;
-  }
+  sql::Database& db = *payments_db.db();
 
   const char query[] =
       "SELECT name_on_card, expiration_month, expiration_year, "
@@ -32,6 +32,11 @@ class Database;
 
 class ChromeImporter : public Importer {
  public:
+  // History rows and favicons are handed to the bridge in batches of at most
+  // this many entries, so memory use doesn't grow with the source profile.
+  static constexpr size_t kHistoryBatchSize = 1000;
+  static constexpr size_t kFaviconBatchSize = 100;
+
   ChromeImporter();
 
   // Importer:
@@ -60,10 +65,8 @@ class ChromeImporter : public Importer {
   // Loads the urls associated with the favicons into favicon_map;
   void ImportFaviconURLs(sql::Database* db, FaviconMap* favicon_map);
 
-  // Loads and reencodes the individual favicons.
-  void LoadFaviconData(sql::Database* db,
-                       const FaviconMap& favicon_map,
-                       favicon_base::FaviconUsageDataList* favicons);
+  // Loads and reencodes the individual favicons and sends them to the bridge.
+  void LoadFaviconData(sql::Database* db, const FaviconMap& favicon_map);
 
   void RecursiveReadBookmarksFolder(
       const base::DictionaryValue* folder,
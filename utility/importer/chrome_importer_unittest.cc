@@ -6,6 +6,7 @@
 #include "brave/utility/importer/chrome_importer.h"
 
 #include <string>
+#include <vector>
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
@@ -20,7 +21,10 @@
 #include "chrome/common/importer/mock_importer_bridge.h"
 #include "components/favicon_base/favicon_usage_data.h"
 #include "components/os_crypt/os_crypt_mocker.h"
+#include "sql/database.h"
+#include "sql/statement.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "ui/base/page_transition_types.h"
 
 using base::UTF16ToASCII;
 using ::testing::_;
@@ -86,6 +90,71 @@ TEST_F(ChromeImporterTest, ImportHistory) {
   EXPECT_EQ("https://www.nytimes.com/", history[2].url.spec());
 }
 
+TEST_F(ChromeImporterTest, ImportLargeHistoryInBatches) {
+  // Replace the fixture with a synthetic History holding more urls than fit
+  // in one batch, each visited several times.
+  const base::FilePath history_path = profile_dir_.AppendASCII("History");
+  ASSERT_TRUE(base::DeleteFile(history_path));
+  {
+    sql::Database db;
+    ASSERT_TRUE(db.Open(history_path));
+    ASSERT_TRUE(db.Execute(
+        "CREATE TABLE urls(id INTEGER PRIMARY KEY, url LONGVARCHAR, "
+        "title LONGVARCHAR, visit_count INTEGER, typed_count INTEGER, "
+        "last_visit_time INTEGER, hidden INTEGER DEFAULT 0)"));
+    ASSERT_TRUE(db.Execute(
+        "CREATE TABLE visits(id INTEGER PRIMARY KEY, url INTEGER, "
+        "visit_time INTEGER, transition INTEGER)"));
+    ASSERT_TRUE(db.Execute("CREATE INDEX visits_url_index ON visits (url)"));
+
+    sql::Statement add_url(db.GetUniqueStatement(
+        "INSERT INTO urls(id, url, title, visit_count, typed_count) "
+        "VALUES (?, ?, 'title', 3, 1)"));
+    sql::Statement add_visit(db.GetUniqueStatement(
+        "INSERT INTO visits(url, visit_time, transition) VALUES (?, ?, ?)"));
+    ASSERT_TRUE(db.BeginTransaction());
+    for (size_t i = 1; i <= ChromeImporter::kHistoryBatchSize * 2 + 1; ++i) {
+      add_url.BindInt64(0, i);
+      add_url.BindString(1, "https://example" + std::to_string(i) + ".com/");
+      ASSERT_TRUE(add_url.Run());
+      add_url.Reset(true);
+      for (int visit = 0; visit < 3; ++visit) {
+        add_visit.BindInt64(0, i);
+        add_visit.BindInt64(1, 13165369272568785 + visit);
+        add_visit.BindInt64(
+            2, ui::PAGE_TRANSITION_LINK | ui::PAGE_TRANSITION_CHAIN_END);
+        ASSERT_TRUE(add_visit.Run());
+        add_visit.Reset(true);
+      }
+    }
+    ASSERT_TRUE(db.CommitTransaction());
+  }
+
+  std::vector<size_t> batch_sizes;
+  std::vector<ImporterURLRow> history;
+  EXPECT_CALL(*bridge_, NotifyStarted());
+  EXPECT_CALL(*bridge_, NotifyItemStarted(importer::HISTORY));
+  EXPECT_CALL(*bridge_, SetHistoryItems(_, _))
+      .WillRepeatedly([&](const std::vector<ImporterURLRow>& rows,
+                          importer::VisitSource visit_source) {
+        batch_sizes.push_back(rows.size());
+        history.insert(history.end(), rows.begin(), rows.end());
+      });
+  EXPECT_CALL(*bridge_, NotifyItemEnded(importer::HISTORY));
+  EXPECT_CALL(*bridge_, NotifyEnded());
+
+  importer_->StartImport(profile_, importer::HISTORY, bridge_.get());
+
+  // Every url is sent once, in bounded batches.
+  EXPECT_EQ(std::vector<size_t>({ChromeImporter::kHistoryBatchSize,
+                                 ChromeImporter::kHistoryBatchSize, 1u}),
+            batch_sizes);
+  ASSERT_EQ(ChromeImporter::kHistoryBatchSize * 2 + 1, history.size());
+  EXPECT_EQ("https://example1.com/", history.front().url.spec());
+  EXPECT_EQ(3, history.front().visit_count);
+  EXPECT_EQ(history.back().last_visit, history.front().last_visit);
+}
+
 TEST_F(ChromeImporterTest, ImportBookmarks) {
   std::vector<ImportedBookmarkEntry> bookmarks;
 